@@ -52,25 +52,10 @@ AssemblyItem const& Assembly::append(AssemblyItem const& _i)
 	return m_items.back();
 }
 
-unsigned Assembly::bytesRequired(unsigned subTagSize) const
-{
-	for (unsigned tagSize = subTagSize; true; ++tagSize)
-	{
-		unsigned ret = 1;
-		for (auto const& i: m_data)
-			ret += i.second.size();
-
-		for (AssemblyItem const& i: m_items)
-			ret += i.bytesRequired(tagSize);
-		if (util::bytesRequired(ret) <= tagSize)
-			return ret;
-	}
-}
-
 namespace
 {
 
-string locationFromSources(StringMap const& _sourceCodes, SourceLocation const& _location)
+string locationFromSources(SharedStringMap const& _sourceCodes, SourceLocation const& _location)
 {
 	if (!_location.hasText() || _sourceCodes.empty())
 		return "";
@@ -79,7 +64,7 @@ string locationFromSources(StringMap const& _sourceCodes, SourceLocation const&
 	if (it == _sourceCodes.end())
 		return "";
 
-	string const& source = it->second;
+	string const& source = *it->second;
 	if (static_cast<size_t>(_location.start) >= source.size())
 		return "";
 
@@ -94,7 +79,7 @@ string locationFromSources(StringMap const& _sourceCodes, SourceLocation const&
 class Functionalizer
 {
 public:
-	Functionalizer (ostream& _out, string const& _prefix, StringMap const& _sourceCodes, Assembly const& _assembly):
+	Functionalizer (ostream& _out, string const& _prefix, SharedStringMap const& _sourceCodes, Assembly const& _assembly):
 		m_out(_out), m_prefix(_prefix), m_sourceCodes(_sourceCodes), m_assembly(_assembly)
 	{}
 
@@ -163,13 +148,13 @@ private:
 
 	ostream& m_out;
 	string const& m_prefix;
-	StringMap const& m_sourceCodes;
+	SharedStringMap const& m_sourceCodes;
 	Assembly const& m_assembly;
 };
 
 }
 
-void Assembly::assemblyStream(ostream& _out, string const& _prefix, StringMap const& _sourceCodes) const
+void Assembly::assemblyStream(ostream& _out, string const& _prefix, SharedStringMap const& _sourceCodes) const
 {
 	Functionalizer f(_out, _prefix, _sourceCodes, *this);
 
@@ -196,7 +181,7 @@ void Assembly::assemblyStream(ostream& _out, string const& _prefix, StringMap co
 		_out << endl << _prefix << "auxdata: 0x" << toHex(m_auxiliaryData) << endl;
 }
 
-string Assembly::assemblyString(StringMap const& _sourceCodes) const
+string Assembly::assemblyString(SharedStringMap const& _sourceCodes) const
 {
 	ostringstream tmp;
 	assemblyStream(tmp, "", _sourceCodes);
@@ -536,7 +521,6 @@ LinkerObject const& Assembly::assemble() const
 
 	LinkerObject& ret = m_assembledObject;
 
-	size_t subTagSize = 1;
 	map<u256, pair<string, vector<size_t>>> immutableReferencesBySub;
 	for (auto const& sub: m_subs)
 	{
@@ -550,9 +534,6 @@ LinkerObject const& Assembly::assemble() const
 			);
 			immutableReferencesBySub = linkerObject.immutableReferences;
 		}
-		for (size_t tagPos: sub->m_tagPositionsInBytecode)
-			if (tagPos != numeric_limits<size_t>::max() && tagPos > subTagSize)
-				subTagSize = tagPos;
 	}
 
 	bool setsImmutables = false;
@@ -573,29 +554,18 @@ LinkerObject const& Assembly::assemble() const
 			"Cannot push and assign immutables in the same assembly subroutine."
 		);
 
-	size_t bytesRequiredForCode = bytesRequired(subTagSize);
-	m_tagPositionsInBytecode = vector<size_t>(m_usedTags, numeric_limits<size_t>::max());
-	map<size_t, pair<size_t, size_t>> tagRef;
+	Layout const layout = computeLayout(immutableReferencesBySub);
+	m_tagPositionsInBytecode = layout.tagPositions;
 	multimap<h256, unsigned> dataRef;
 	multimap<size_t, size_t> subRef;
 	vector<unsigned> sizeRef; ///< Pointers to code locations where the size of the program is inserted
-	unsigned bytesPerTag = util::bytesRequired(bytesRequiredForCode);
-	uint8_t tagPush = (uint8_t)pushInstruction(bytesPerTag);
-
-	unsigned bytesRequiredIncludingData = bytesRequiredForCode + 1 + m_auxiliaryData.size();
-	for (auto const& sub: m_subs)
-		bytesRequiredIncludingData += sub->assemble().bytecode.size();
-
-	unsigned bytesPerDataRef = util::bytesRequired(bytesRequiredIncludingData);
+	size_t tagReferenceIndex = 0;
+	unsigned bytesPerDataRef = layout.dataReferenceWidth;
 	uint8_t dataRefPush = (uint8_t)pushInstruction(bytesPerDataRef);
-	ret.bytecode.reserve(bytesRequiredIncludingData);
+	ret.bytecode.reserve(layout.totalSize);
 
 	for (AssemblyItem const& i: m_items)
 	{
-		// store position of the invalid jump destination
-		if (i.type() != Tag && m_tagPositionsInBytecode[0] == numeric_limits<size_t>::max())
-			m_tagPositionsInBytecode[0] = ret.bytecode.size();
-
 		switch (i.type())
 		{
 		case Operation:
@@ -625,9 +595,14 @@ LinkerObject const& Assembly::assemble() const
 		}
 		case PushTag:
 		{
-			ret.bytecode.push_back(tagPush);
-			tagRef[ret.bytecode.size()] = i.splitForeignPushTag();
+			unsigned bytesPerTag = layout.tagReferenceWidths[tagReferenceIndex++];
+			size_t pos = tagPosition(i, m_tagPositionsInBytecode);
+			assertThrow(pos != numeric_limits<size_t>::max(), AssemblyException, "Reference to tag without position.");
+			assertThrow(util::bytesRequired(pos) <= bytesPerTag, AssemblyException, "Tag too large for reserved space.");
+			ret.bytecode.push_back((uint8_t)pushInstruction(bytesPerTag));
 			ret.bytecode.resize(ret.bytecode.size() + bytesPerTag);
+			bytesRef r(ret.bytecode.data() + ret.bytecode.size() - bytesPerTag, bytesPerTag);
+			toBigEndian(pos, r);
 			break;
 		}
 		case PushData:
@@ -692,8 +667,7 @@ LinkerObject const& Assembly::assemble() const
 			assertThrow(i.data() != 0, AssemblyException, "Invalid tag position.");
 			assertThrow(i.splitForeignPushTag().first == numeric_limits<size_t>::max(), AssemblyException, "Foreign tag.");
 			assertThrow(ret.bytecode.size() < 0xffffffffL, AssemblyException, "Tag too large.");
-			assertThrow(m_tagPositionsInBytecode[static_cast<size_t>(i.data())] == numeric_limits<size_t>::max(), AssemblyException, "Duplicate tag position.");
-			m_tagPositionsInBytecode[static_cast<size_t>(i.data())] = ret.bytecode.size();
+			assertThrow(m_tagPositionsInBytecode[static_cast<size_t>(i.data())] == ret.bytecode.size(), AssemblyException, "Tag position differs from layout.");
 			ret.bytecode.push_back((uint8_t)Instruction::JUMPDEST);
 			break;
 		default:
@@ -717,23 +691,6 @@ LinkerObject const& Assembly::assemble() const
 		ret.append(subAssemblyById(subIdPath)->assemble());
 	}
 
-	for (auto const& i: tagRef)
-	{
-		size_t subId;
-		size_t tagId;
-		tie(subId, tagId) = i.second;
-		assertThrow(subId == numeric_limits<size_t>::max() || subId < m_subs.size(), AssemblyException, "Invalid sub id");
-		vector<size_t> const& tagPositions =
-			subId == numeric_limits<size_t>::max() ?
-			m_tagPositionsInBytecode :
-			m_subs[subId]->m_tagPositionsInBytecode;
-		assertThrow(tagId < tagPositions.size(), AssemblyException, "Reference to non-existing tag.");
-		size_t pos = tagPositions[tagId];
-		assertThrow(pos != numeric_limits<size_t>::max(), AssemblyException, "Reference to tag without position.");
-		assertThrow(util::bytesRequired(pos) <= bytesPerTag, AssemblyException, "Tag too large for reserved space.");
-		bytesRef r(ret.bytecode.data() + i.first, bytesPerTag);
-		toBigEndian(pos, r);
-	}
 	for (auto const& dataItem: m_data)
 	{
 		auto references = dataRef.equal_range(dataItem.first);
@@ -757,6 +714,125 @@ LinkerObject const& Assembly::assemble() const
 	return ret;
 }
 
+Assembly::Layout Assembly::computeLayout(
+	map<u256, pair<string, vector<size_t>>> const& _immutableReferencesBySub
+) const
+{
+	// Sizes of the items without the pushed values of references, whose widths are determined below.
+	vector<size_t> itemSizes;
+	itemSizes.reserve(m_items.size());
+	size_t tagReferenceCount = 0;
+	// Upper bound for the size of everything that is appended to the code.
+	size_t appendedSize = 1 + m_auxiliaryData.size();
+	for (auto const& data: m_data)
+		appendedSize += data.second.size();
+	set<u256> assignedImmutables;
+	for (AssemblyItem const& i: m_items)
+		switch (i.type())
+		{
+		case PushTag:
+			tagReferenceCount++;
+			itemSizes.push_back(1);
+			break;
+		case PushSub:
+			appendedSize += subAssemblyById(static_cast<size_t>(i.data()))->assemble().bytecode.size();
+			itemSizes.push_back(1);
+			break;
+		case PushData:
+		case PushProgramSize:
+			itemSizes.push_back(1);
+			break;
+		case PushSubSize:
+		{
+			size_t subSize = subAssemblyById(static_cast<size_t>(i.data()))->assemble().bytecode.size();
+			itemSizes.push_back(1 + max<size_t>(1, util::bytesRequired(subSize)));
+			break;
+		}
+		case AssignImmutable:
+		{
+			size_t size = 1;
+			auto references = _immutableReferencesBySub.find(i.data());
+			if (references != _immutableReferencesBySub.end() && assignedImmutables.insert(i.data()).second)
+				for (size_t offset: references->second.second)
+					size += 3 + toCompactBigEndian(u256(offset)).size();
+			itemSizes.push_back(size);
+			break;
+		}
+		default:
+			// The size of all other items does not depend on the address length.
+			itemSizes.push_back(i.bytesRequired(0));
+		}
+
+	Layout layout;
+	layout.tagReferenceWidths.assign(tagReferenceCount, 1);
+	while (true)
+	{
+		layout.tagPositions.assign(m_usedTags, numeric_limits<size_t>::max());
+		size_t position = 0;
+		size_t tagReferenceIndex = 0;
+		for (size_t index = 0; index < m_items.size(); ++index)
+		{
+			AssemblyItem const& i = m_items[index];
+			// store position of the invalid jump destination
+			if (i.type() != Tag && layout.tagPositions[0] == numeric_limits<size_t>::max())
+				layout.tagPositions[0] = position;
+			if (i.type() == Tag)
+			{
+				assertThrow(i.data() != 0, AssemblyException, "Invalid tag position.");
+				assertThrow(i.splitForeignPushTag().first == numeric_limits<size_t>::max(), AssemblyException, "Foreign tag.");
+				assertThrow(position < 0xffffffffL, AssemblyException, "Tag too large.");
+				size_t tag = static_cast<size_t>(i.data());
+				assertThrow(tag < m_usedTags, AssemblyException, "Reference to non-existing tag.");
+				assertThrow(layout.tagPositions[tag] == numeric_limits<size_t>::max(), AssemblyException, "Duplicate tag position.");
+				layout.tagPositions[tag] = position;
+			}
+			position += itemSizes[index];
+			if (i.type() == PushTag)
+				position += layout.tagReferenceWidths[tagReferenceIndex++];
+			else if (i.type() == PushData || i.type() == PushSub || i.type() == PushProgramSize)
+				position += layout.dataReferenceWidth;
+		}
+		layout.totalSize = position + appendedSize;
+
+		// Widening a reference only moves the following items further back,
+		// so the widths only grow and the loop terminates.
+		bool changed = false;
+		tagReferenceIndex = 0;
+		for (AssemblyItem const& i: m_items)
+			if (i.type() == PushTag)
+			{
+				size_t pos = tagPosition(i, layout.tagPositions);
+				unsigned& width = layout.tagReferenceWidths[tagReferenceIndex++];
+				if (pos != numeric_limits<size_t>::max() && util::bytesRequired(pos) > width)
+				{
+					width = util::bytesRequired(pos);
+					changed = true;
+				}
+			}
+		if (util::bytesRequired(layout.totalSize) > layout.dataReferenceWidth)
+		{
+			layout.dataReferenceWidth = util::bytesRequired(layout.totalSize);
+			changed = true;
+		}
+		if (!changed)
+			return layout;
+	}
+}
+
+size_t Assembly::tagPosition(AssemblyItem const& _pushTag, vector<size_t> const& _tagPositions) const
+{
+	size_t subId;
+	size_t tagId;
+	tie(subId, tagId) = _pushTag.splitForeignPushTag();
+	assertThrow(subId == numeric_limits<size_t>::max() || subId < m_subs.size(), AssemblyException, "Invalid sub id");
+	vector<size_t> const& tagPositions =
+		subId == numeric_limits<size_t>::max() ?
+		_tagPositions :
+		m_subs[subId]->m_tagPositionsInBytecode;
+	assertThrow(tagId < tagPositions.size(), AssemblyException, "Reference to non-existing tag.");
+	return tagPositions[tagId];
+}
+
 vector<size_t> Assembly::decodeSubPath(size_t _subObjectId) const
 {
 	if (_subObjectId < m_subs.size())
@@ -130,12 +130,12 @@ public:
 
 	/// Create a text representation of the assembly.
 	std::string assemblyString(
-		StringMap const& _sourceCodes = StringMap()
+		SharedStringMap const& _sourceCodes = SharedStringMap()
 	) const;
 	void assemblyStream(
 		std::ostream& _out,
 		std::string const& _prefix = "",
-		StringMap const& _sourceCodes = StringMap()
+		SharedStringMap const& _sourceCodes = SharedStringMap()
 	) const;
 
 	/// Create a JSON representation of the assembly.
@@ -155,9 +155,29 @@ protected:
 	/// that are referenced in a super-assembly.
 	std::map<u256, u256> optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
 
-	unsigned bytesRequired(unsigned subTagSize) const;
-
 private:
+	/// Positions and push widths determined before the bytecode is generated.
+	struct Layout
+	{
+		/// Width of the pushed value of each tag reference, in the order of the items.
+		std::vector<unsigned> tagReferenceWidths;
+		/// Width of the pushed value of references to data, sub-assemblies and the program size.
+		unsigned dataReferenceWidth = 1;
+		/// Position of each tag of this assembly in the bytecode.
+		std::vector<size_t> tagPositions;
+		/// Upper bound for the size of the bytecode including appended data.
+		size_t totalSize = 0;
+	};
+	/// Computes the smallest widths for all references that fit the values they push.
+	/// Since the positions depend on the widths, the widths are determined by starting
+	/// with one byte each and widening them until no position changes anymore.
+	Layout computeLayout(
+		std::map<u256, std::pair<std::string, std::vector<size_t>>> const& _immutableReferencesBySub
+	) const;
+	/// @returns the position of the tag pushed by @a _pushTag, which can be a tag of a sub-assembly,
+	/// using @a _tagPositions for tags of this assembly.
+	size_t tagPosition(AssemblyItem const& _pushTag, std::vector<size_t> const& _tagPositions) const;
+
 	static Json::Value createJsonValue(
 		std::string _name,
 		int _source,
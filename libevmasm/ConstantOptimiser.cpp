@@ -24,6 +24,9 @@
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Parallel.h>
+
+#include <mutex>
 
 using namespace std;
 using namespace solidity;
@@ -44,7 +47,8 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 	for (AssemblyItem const& item: _items)
 		if (item.type() == Push)
 			pushes[item]++;
-	map<u256, AssemblyItems> pendingReplacements;
+
+	vector<pair<Params, u256>> constants;
 	for (auto it: pushes)
 	{
 		AssemblyItem const& item = it.first;
@@ -55,31 +59,79 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 		params.isCreation = _isCreation;
 		params.runs = _runs;
 		params.evmVersion = _evmVersion;
-		LiteralMethod lit(params, item.data());
-		bigint literalGas = lit.gasNeeded();
-		CodeCopyMethod copy(params, item.data());
-		bigint copyGas = copy.gasNeeded();
-		ComputeMethod compute(params, item.data());
-		bigint computeGas = compute.gasNeeded();
+		constants.emplace_back(params, item.data());
+	}
+
+	// The search for each constant is independent of the others and of the assembly,
+	// so it is done in parallel if there are enough constants to make it worthwhile.
+	vector<Choice const*> choices(constants.size(), nullptr);
+	util::parallelFor(
+		constants.size(),
+		[&](size_t _index) { choices[_index] = &cheapestMethod(constants[_index].first, constants[_index].second); },
+		constants.size() >= 16 ? util::defaultThreadCount() : 1
+	);
+
+	map<u256, AssemblyItems> pendingReplacements;
+	for (size_t i = 0; i < constants.size(); ++i)
+	{
+		auto const& [params, value] = constants[i];
 		AssemblyItems replacement;
-		if (copyGas < literalGas && copyGas < computeGas)
+		switch (choices[i]->method)
 		{
-			replacement = copy.execute(_assembly);
+		case Choice::Method::Literal:
+			break;
+		case Choice::Method::CodeCopy:
+			replacement = CodeCopyMethod(params, value).execute(_assembly);
 			optimisations++;
-		}
-		else if (computeGas < literalGas && computeGas <= copyGas)
-		{
-			replacement = compute.execute(_assembly);
+			break;
+		case Choice::Method::Compute:
+			replacement = choices[i]->routine;
 			optimisations++;
+			break;
 		}
 		if (!replacement.empty())
-			pendingReplacements[item.data()] = replacement;
+			pendingReplacements[value] = replacement;
 	}
 	if (!pendingReplacements.empty())
 		replaceConstants(_items, pendingReplacements);
 	return optimisations;
 }
 
+ConstantOptimisationMethod::Choice const& ConstantOptimisationMethod::cheapestMethod(
+	Params const& _params,
+	u256 const& _value
+)
+{
+	static mutex cacheMutex;
+	// Elements of a map are not moved by insertions, so references to them stay valid.
+	static map<pair<Params, u256>, Choice> cache;
+
+	pair<Params, u256> key{_params, _value};
+	{
+		lock_guard<mutex> lock(cacheMutex);
+		if (auto it = cache.find(key); it != cache.end())
+			return it->second;
+	}
+
+	Choice choice;
+	LiteralMethod lit(_params, _value);
+	bigint literalGas = lit.gasNeeded();
+	CodeCopyMethod copy(_params, _value);
+	bigint copyGas = copy.gasNeeded();
+	ComputeMethod compute(_params, _value);
+	bigint computeGas = compute.gasNeeded();
+	if (copyGas < literalGas && copyGas < computeGas)
+		choice.method = Choice::Method::CodeCopy;
+	else if (computeGas < literalGas && computeGas <= copyGas)
+	{
+		choice.method = Choice::Method::Compute;
+		choice.routine = compute.routine();
+	}
+
+	lock_guard<mutex> lock(cacheMutex);
+	return cache.emplace(move(key), move(choice)).first->second;
+}
+
 bigint ConstantOptimisationMethod::simpleRunGas(AssemblyItems const& _items)
 {
 	bigint gas = 0;
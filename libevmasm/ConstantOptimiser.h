@@ -30,6 +30,7 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 
+#include <tuple>
 #include <vector>
 
 namespace solidity::evmasm
@@ -64,7 +65,26 @@ protected:
 		size_t runs; ///< Estimated number of calls per opcode oven the lifetime of the contract.
 		size_t multiplicity; ///< Number of times the constant appears in the code.
 		langutil::EVMVersion evmVersion; ///< Version of the EVM
+
+		bool operator<(Params const& _other) const
+		{
+			return
+				std::tie(isCreation, runs, multiplicity, evmVersion) <
+				std::tie(_other.isCreation, _other.runs, _other.multiplicity, _other.evmVersion);
+		}
+	};
+
+	/// The cheapest method found for a constant. The routine is only set for ComputeMethod,
+	/// because the code of CodeCopyMethod depends on the assembly.
+	struct Choice
+	{
+		enum class Method { Literal, CodeCopy, Compute };
+		Method method = Method::Literal;
+		AssemblyItems routine;
 	};
+	/// @returns the cheapest way to represent @a _value. The result only depends on the
+	/// arguments and is cached for the lifetime of the process.
+	static Choice const& cheapestMethod(Params const& _params, u256 const& _value);
 
 	explicit ConstantOptimisationMethod(Params const& _params, u256 const& _value):
 		m_params(_params), m_value(_value) {}
@@ -149,6 +169,7 @@ public:
 	{
 		return m_routine;
 	}
+	AssemblyItems const& routine() const { return m_routine; }
 
 protected:
 	/// Tries to recursively find a way to compute @a _value.
@@ -53,6 +53,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -64,18 +65,22 @@ namespace solidity::langutil
  * Bidirectional stream of characters.
  *
  * This CharStream is used by lexical analyzers as the source.
+ * The source text is immutable and shared between copies of the stream
+ * and everyone else holding the same buffer.
  */
 class CharStream
 {
 public:
-	CharStream() = default;
-	explicit CharStream(std::string  _source, std::string  name):
-		m_source(std::move(_source)), m_name(std::move(name)) {}
+	CharStream(): m_source(std::make_shared<std::string const>()) {}
+	explicit CharStream(std::string _source, std::string _name):
+		CharStream(std::make_shared<std::string const>(std::move(_source)), std::move(_name)) {}
+	explicit CharStream(std::shared_ptr<std::string const> _source, std::string _name):
+		m_source(std::move(_source)), m_name(std::move(_name)) {}
 
 	size_t position() const { return m_position; }
-	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source.size(); }
+	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source->size(); }
 
-	char get(size_t _charsForward = 0) const { return m_source[m_position + _charsForward]; }
+	char get(size_t _charsForward = 0) const { return (*m_source)[m_position + _charsForward]; }
 	char advanceAndGet(size_t _chars = 1);
 	/// Sets scanner position to @ _amount characters backwards in source text.
 	/// @returns The character of the current location after update is returned.
@@ -87,7 +92,8 @@ public:
 
 	void reset() { m_position = 0; }
 
-	std::string const& source() const noexcept { return m_source; }
+	std::string const& source() const noexcept { return *m_source; }
+	std::shared_ptr<std::string const> const& sourceBuffer() const noexcept { return m_source; }
 	std::string const& name() const noexcept { return m_name; }
 
 	///@{
@@ -99,7 +105,7 @@ public:
 	///@}
 
 private:
-	std::string m_source;
+	std::shared_ptr<std::string const> m_source;
 	std::string m_name;
 	size_t m_position{0};
 };
@@ -55,6 +55,7 @@
 #include <liblangutil/Scanner.h>
 
 #include <algorithm>
+#include <cstring>
 #include <optional>
 #include <ostream>
 #include <tuple>
@@ -91,6 +92,66 @@ ostream& operator<<(ostream& os, ScannerError _errorCode)
 	return os << to_string(_errorCode);
 }
 
+namespace
+{
+
+/// @returns true if there is a unicode line break at @a _position in @a _source.
+/// See Scanner::isUnicodeLinebreak.
+bool isUnicodeLinebreakAt(string const& _source, size_t _position)
+{
+	auto byteAt = [&](size_t _offset) -> uint8_t
+	{
+		return _position + _offset < _source.size() ? uint8_t(_source[_position + _offset]) : 0;
+	};
+	uint8_t const first = byteAt(0);
+	if (0x0a <= first && first <= 0x0d)
+		return true;
+	else if (first == 0xc2)
+		return byteAt(1) == 0x85;
+	else if (first == 0xe2)
+		return byteAt(1) == 0x80 && (byteAt(2) == 0xa8 || byteAt(2) == 0xa9);
+	else
+		return false;
+}
+
+/// @returns the position of the first unicode line break at or after @a _position in @a _source
+/// or the size of @a _source if there is none.
+size_t findUnicodeLinebreak(string const& _source, size_t _position)
+{
+	// All line breaks start with a byte below 0x0e or a byte of at least 0x80.
+	// Eight bytes at a time are tested for such bytes and skipped if there are none.
+	uint64_t constexpr lowBits = 0x0101010101010101;
+	uint64_t constexpr highBits = 0x8080808080808080;
+	while (_position + 8 <= _source.size())
+	{
+		uint64_t word;
+		memcpy(&word, _source.data() + _position, 8);
+		if (!(((word - lowBits * 0x0e) | word) & highBits))
+		{
+			_position += 8;
+			continue;
+		}
+		for (size_t end = _position + 8; _position < end; ++_position)
+			if (isUnicodeLinebreakAt(_source, _position))
+				return _position;
+	}
+	while (_position < _source.size() && !isUnicodeLinebreakAt(_source, _position))
+		++_position;
+	return _position;
+}
+
+/// @returns the position of the first character at or after @a _position in @a _source
+/// that does not satisfy @a _predicate or the size of @a _source if there is none.
+template <typename Predicate>
+size_t findEndOf(string const& _source, size_t _position, Predicate const& _predicate)
+{
+	while (_position < _source.size() && _predicate(_source[_position]))
+		++_position;
+	return _position;
+}
+
+}
+
 /// Scoped helper for literal recording. Automatically drops the literal
 /// if aborting the scanning before it's complete.
 enum LiteralType
@@ -216,6 +277,18 @@ void Scanner::addUnicodeAsUTF8(unsigned codepoint)
 	}
 }
 
+void Scanner::addLiteralAndAdvanceTo(size_t _end)
+{
+	m_tokens[NextNext].literal.append(m_source->source(), sourcePos(), _end - sourcePos());
+	advanceTo(_end);
+}
+
+void Scanner::addCommentLiteralAndAdvanceTo(size_t _end)
+{
+	m_skippedComments[NextNext].literal.append(m_source->source(), sourcePos(), _end - sourcePos());
+	advanceTo(_end);
+}
+
 void Scanner::rescan()
 {
 	size_t rollbackTo = 0;
@@ -255,11 +328,12 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 
 bool Scanner::skipWhitespace()
 {
-	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
-		advance();
-	// Return whether or not we skipped any characters.
-	return sourcePos() != startPosition;
+	// The current character is tested separately, since it is
+	// replaced by a space after multi-line comments.
+	if (!isWhiteSpace(m_char))
+		return false;
+	advanceTo(findEndOf(m_source->source(), sourcePos() + 1, isWhiteSpace));
+	return true;
 }
 
 bool Scanner::skipWhitespaceExceptUnicodeLinebreak()
@@ -275,9 +349,7 @@ Token Scanner::skipSingleLineComment()
 {
 	// Line terminator is not part of the comment. If it is a
 	// non-ascii line terminator, it will result in a parser error.
-	while (!isUnicodeLinebreak())
-		if (!advance()) break;
-
+	advanceTo(findUnicodeLinebreak(m_source->source(), sourcePos()));
 	return Token::Whitespace;
 }
 
@@ -342,6 +414,7 @@ size_t Scanner::scanSingleLineDocComment()
 			break;
 		addCommentLiteralChar(m_char);
 		advance();
+		addCommentLiteralAndAdvanceTo(findUnicodeLinebreak(m_source->source(), sourcePos()));
 	}
 	literal.complete();
 	return endPosition;
@@ -349,22 +422,20 @@ size_t Scanner::scanSingleLineDocComment()
 
 Token Scanner::skipMultiLineComment()
 {
-	while (!isSourcePastEndOfInput())
+	size_t const end = m_source->source().find("*/", sourcePos());
+	if (end == string::npos)
 	{
-		char ch = m_char;
-		advance();
-
-		// If we have reached the end of the multi-line comment, we
-		// consume the '/' and insert a whitespace. This way all
-		// multi-line comments are treated as whitespace.
-		if (ch == '*' && m_char == '/')
-		{
-			m_char = ' ';
-			return Token::Whitespace;
-		}
+		// Unterminated multi-line comment.
+		advanceTo(m_source->source().size());
+		return setError(ScannerError::IllegalCommentTerminator);
 	}
-	// Unterminated multi-line comment.
-	return setError(ScannerError::IllegalCommentTerminator);
+
+	// We have reached the end of the multi-line comment, so we
+	// consume the '/' and insert a whitespace. This way all
+	// multi-line comments are treated as whitespace.
+	advanceTo(end + 1);
+	m_char = ' ';
+	return Token::Whitespace;
 }
 
 Token Scanner::scanMultiLineDocComment()
@@ -414,6 +485,9 @@ Token Scanner::scanMultiLineDocComment()
 		addCommentLiteralChar(m_char);
 		charsAdded = true;
 		advance();
+		// Add the rest of the line up to a potential end of the comment at once.
+		size_t const end = m_source->source().find_first_of("*\n\r", sourcePos());
+		addCommentLiteralAndAdvanceTo(end == string::npos ? m_source->source().size() : end);
 	}
 	literal.complete();
 	if (!endFound)
@@ -808,6 +882,10 @@ Token Scanner::scanString(bool const _isUnicode)
 			if (!_isUnicode && (static_cast<unsigned>(c) <= 0x1f || static_cast<unsigned>(c) >= 0x7f))
 				return setError(ScannerError::IllegalCharacterInString);
 			addLiteralChar(c);
+			// Add the following printable characters at once.
+			addLiteralAndAdvanceTo(findEndOf(m_source->source(), sourcePos(), [&](char _c) {
+				return _c != quote && _c != '\\' && 0x20 <= _c && _c < 0x7f;
+			}));
 		}
 	}
 	if (m_char != quote)
@@ -859,9 +937,10 @@ void Scanner::scanDecimalDigits()
 		return;
 
 	// May continue with decimal digit or underscore for grouping.
-	do
-		addLiteralCharAndAdvance();
-	while (!m_source->isPastEndOfInput() && (isDecimalDigit(m_char) || m_char == '_'));
+	addLiteralCharAndAdvance();
+	addLiteralAndAdvanceTo(findEndOf(m_source->source(), sourcePos(), [](char _c) {
+		return isDecimalDigit(_c) || _c == '_';
+	}));
 
 	// Defer further validation of underscore to SyntaxChecker.
 }
@@ -894,8 +973,10 @@ Token Scanner::scanNumber(char _charSeen)
 				if (!isHexDigit(m_char))
 					return setError(ScannerError::IllegalHexDigit); // we must have at least one hex digit after 'x'
 
-				while (isHexDigit(m_char) || m_char == '_') // We keep the underscores for later validation
-					addLiteralCharAndAdvance();
+				// We keep the underscores for later validation
+				addLiteralAndAdvanceTo(findEndOf(m_source->source(), sourcePos(), [](char _c) {
+					return isHexDigit(_c) || _c == '_';
+				}));
 			}
 			else if (isDecimalDigit(m_char))
 				// We do not allow octal numbers
@@ -966,8 +1047,9 @@ tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
 	addLiteralCharAndAdvance();
 	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_kind == ScannerKind::Yul))
-		addLiteralCharAndAdvance();
+	addLiteralAndAdvanceTo(findEndOf(m_source->source(), sourcePos(), [&](char _c) {
+		return isIdentifierPart(_c) || (_c == '.' && m_kind == ScannerKind::Yul);
+	}));
 	literal.complete();
 	auto const token = TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
 	if (m_kind == ScannerKind::Yul)
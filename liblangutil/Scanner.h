@@ -204,10 +204,15 @@ private:
 	inline void addLiteralChar(char c) { m_tokens[NextNext].literal.push_back(c); }
 	inline void addCommentLiteralChar(char c) { m_skippedComments[NextNext].literal.push_back(c); }
 	inline void addLiteralCharAndAdvance() { addLiteralChar(m_char); advance(); }
+	/// Adds the source text from the current position up to @a _end to the literal and advances to @a _end.
+	void addLiteralAndAdvanceTo(size_t _end);
+	void addCommentLiteralAndAdvanceTo(size_t _end);
 	void addUnicodeAsUTF8(unsigned codepoint);
 	///@}
 
 	bool advance() { m_char = m_source->advanceAndGet(); return !m_source->isPastEndOfInput(); }
+	/// Advances to @a _position, which is at most the end of the source.
+	void advanceTo(size_t _position) { m_char = m_source->setPosition(_position); }
 	void rollback(size_t _amount) { m_char = m_source->rollback(_amount); }
 	/// Rolls back to the start of the current token and re-runs the scanner.
 	void rescan();
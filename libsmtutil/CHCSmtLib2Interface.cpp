@@ -59,17 +59,17 @@ void CHCSmtLib2Interface::reset()
 
 void CHCSmtLib2Interface::registerRelation(Expression const& _expr)
 {
-	smtAssert(_expr.sort, "");
-	smtAssert(_expr.sort->kind == Kind::Function, "");
-	if (!m_variables.count(_expr.name))
+	smtAssert(_expr.sort(), "");
+	smtAssert(_expr.sort()->kind == Kind::Function, "");
+	if (!m_variables.count(_expr.name()))
 	{
-		auto fSort = dynamic_pointer_cast<FunctionSort>(_expr.sort);
+		auto fSort = dynamic_pointer_cast<FunctionSort>(_expr.sort());
 		string domain = m_smtlib2->toSmtLibSort(fSort->domain);
 		// Relations are predicates which have implicit codomain Bool.
-		m_variables.insert(_expr.name);
+		m_variables.insert(_expr.name());
 		write(
 			"(declare-rel |" +
-			_expr.name +
+			_expr.name() +
 			"| " +
 			domain +
 			")"
@@ -98,7 +98,7 @@ pair<CheckResult, CHCSolverInterface::CexGraph> CHCSmtLib2Interface::query(Expre
 
 	string response = querySolver(
 		m_accumulatedOutput +
-		"\n(query " + _block.name + " :print-certificate true)"
+		"\n(query " + _block.name() + " :print-certificate true)"
 	);
 
 	CheckResult result;
@@ -37,6 +37,7 @@ CVC4Interface::CVC4Interface(optional<unsigned> _queryTimeout):
 void CVC4Interface::reset()
 {
 	m_variables.clear();
+	m_exprs.clear();
 	m_solver.reset();
 	m_solver.setOption("produce-models", true);
 	if (m_queryTimeout)
@@ -58,6 +59,9 @@ void CVC4Interface::pop()
 void CVC4Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
+	// Every declaration creates a new variable, which cached translations do not refer to.
+	if (m_variables.count(_name))
+		m_exprs.clear();
 	m_variables[_name] = m_context.mkVar(_name.c_str(), cvc4Sort(*_sort));
 }
 
@@ -122,20 +126,31 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 }
 
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
+{
+	if (_expr.arguments().empty())
+		return translate(_expr);
+
+	auto it = m_exprs.find(_expr.id());
+	if (it == m_exprs.end())
+		it = m_exprs.emplace(_expr.id(), translate(_expr)).first;
+	return it->second;
+}
+
+CVC4::Expr CVC4Interface::translate(Expression const& _expr)
 {
 	// Variable
-	if (_expr.arguments.empty() && m_variables.count(_expr.name))
-		return m_variables.at(_expr.name);
+	if (_expr.arguments().empty() && m_variables.count(_expr.name()))
+		return m_variables.at(_expr.name());
 
 	vector<CVC4::Expr> arguments;
-	for (auto const& arg: _expr.arguments)
+	for (auto const& arg: _expr.arguments())
 		arguments.push_back(toCVC4Expr(arg));
 
 	try
 	{
-		string const& n = _expr.name;
+		string const& n = _expr.name();
 		// Function application
-		if (!arguments.empty() && m_variables.count(_expr.name))
+		if (!arguments.empty() && m_variables.count(_expr.name()))
 			return m_context.mkExpr(CVC4::kind::APPLY_UF, m_variables.at(n), arguments);
 		// Literal
 		else if (arguments.empty())
@@ -144,7 +159,7 @@ CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 				return m_context.mkConst(true);
 			else if (n == "false")
 				return m_context.mkConst(false);
-			else if (auto sortSort = dynamic_pointer_cast<SortSort>(_expr.sort))
+			else if (auto sortSort = dynamic_pointer_cast<SortSort>(_expr.sort()))
 				return m_context.mkVar(n, cvc4Sort(*sortSort->inner));
 			else
 				try
@@ -208,7 +223,7 @@ CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 			return m_context.mkExpr(CVC4::kind::BITVECTOR_ASHR, arguments[0], arguments[1]);
 		else if (n == "int2bv")
 		{
-			size_t size = std::stoul(_expr.arguments[1].name);
+			size_t size = std::stoul(_expr.arguments()[1].name());
 			auto i2bvOp = m_context.mkConst(CVC4::IntToBitVector(size));
 			// CVC4 treats all BVs as unsigned, so we need to manually apply 2's complement if needed.
 			return m_context.mkExpr(
@@ -223,7 +238,7 @@ CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 		}
 		else if (n == "bv2int")
 		{
-			auto intSort = dynamic_pointer_cast<IntSort>(_expr.sort);
+			auto intSort = dynamic_pointer_cast<IntSort>(_expr.sort());
 			smtAssert(intSort, "");
 			auto nat = m_context.mkExpr(CVC4::kind::BITVECTOR_TO_NAT, arguments[0]);
 			if (!intSort->isSigned)
@@ -253,23 +268,23 @@ CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 			return m_context.mkExpr(CVC4::kind::STORE, arguments[0], arguments[1], arguments[2]);
 		else if (n == "const_array")
 		{
-			shared_ptr<SortSort> sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments[0].sort);
+			shared_ptr<SortSort> sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments()[0].sort());
 			smtAssert(sortSort, "");
 			return m_context.mkConst(CVC4::ArrayStoreAll(cvc4Sort(*sortSort->inner), arguments[1]));
 		}
 		else if (n == "tuple_get")
 		{
-			shared_ptr<TupleSort> tupleSort = std::dynamic_pointer_cast<TupleSort>(_expr.arguments[0].sort);
+			shared_ptr<TupleSort> tupleSort = std::dynamic_pointer_cast<TupleSort>(_expr.arguments()[0].sort());
 			smtAssert(tupleSort, "");
 			CVC4::DatatypeType tt = m_context.mkTupleType(cvc4Sort(tupleSort->components));
 			CVC4::Datatype const& dt = tt.getDatatype();
-			size_t index = std::stoul(_expr.arguments[1].name);
+			size_t index = std::stoul(_expr.arguments()[1].name());
 			CVC4::Expr s = dt[0][index].getSelector();
 			return m_context.mkExpr(CVC4::kind::APPLY_SELECTOR, s, arguments[0]);
 		}
 		else if (n == "tuple_constructor")
 		{
-			shared_ptr<TupleSort> tupleSort = std::dynamic_pointer_cast<TupleSort>(_expr.sort);
+			shared_ptr<TupleSort> tupleSort = std::dynamic_pointer_cast<TupleSort>(_expr.sort());
 			smtAssert(tupleSort, "");
 			CVC4::DatatypeType tt = m_context.mkTupleType(cvc4Sort(tupleSort->components));
 			CVC4::Datatype const& dt = tt.getDatatype();
@@ -34,6 +34,8 @@
 #undef _GLIBCXX_PERMIT_BACKWARD_HASH
 #endif
 
+#include <unordered_map>
+
 namespace solidity::smtutil
 {
 
@@ -54,12 +56,16 @@ public:
 
 private:
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
+	/// @returns the CVC4 expression for @a _expr without consulting the cache of translated expressions.
+	CVC4::Expr translate(Expression const& _expr);
 	CVC4::Type cvc4Sort(Sort const& _sort);
 	std::vector<CVC4::Type> cvc4Sort(std::vector<SortPointer> const& _sorts);
 
 	CVC4::ExprManager m_context;
 	CVC4::SmtEngine m_solver;
 	std::map<std::string, CVC4::Expr> m_variables;
+	/// Translations of the expressions with arguments, by expression id.
+	std::unordered_map<size_t, CVC4::Expr> m_exprs;
 
 	// CVC4 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
@@ -55,6 +55,7 @@ void SMTLib2Interface::reset()
 	m_accumulatedOutput.emplace_back();
 	m_variables.clear();
 	m_userSorts.clear();
+	m_sexprs.clear();
 	write("(set-option :produce-models true)");
 	if (m_queryTimeout)
 		write("(set-option :timeout " + to_string(*m_queryTimeout) + ")");
@@ -138,14 +139,22 @@ pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> con
 
 string SMTLib2Interface::toSExpr(Expression const& _expr)
 {
-	if (_expr.arguments.empty())
-		return _expr.name;
+	if (_expr.arguments().empty())
+		return _expr.name();
 
+	auto it = m_sexprs.find(_expr.id());
+	if (it == m_sexprs.end())
+		it = m_sexprs.emplace(_expr.id(), translate(_expr)).first;
+	return it->second;
+}
+
+string SMTLib2Interface::translate(Expression const& _expr)
+{
 	std::string sexpr = "(";
-	if (_expr.name == "int2bv")
+	if (_expr.name() == "int2bv")
 	{
-		size_t size = std::stoul(_expr.arguments[1].name);
-		auto arg = toSExpr(_expr.arguments.front());
+		size_t size = std::stoul(_expr.arguments()[1].name());
+		auto arg = toSExpr(_expr.arguments().front());
 		auto int2bv = "(_ int2bv " + to_string(size) + ")";
 		// Some solvers treat all BVs as unsigned, so we need to manually apply 2's complement if needed.
 		sexpr += string("ite ") +
@@ -153,18 +162,18 @@ string SMTLib2Interface::toSExpr(Expression const& _expr)
 			"(" + int2bv + " " + arg + ") " +
 			"(bvneg (" + int2bv + " (- " + arg + ")))";
 	}
-	else if (_expr.name == "bv2int")
+	else if (_expr.name() == "bv2int")
 	{
-		auto intSort = dynamic_pointer_cast<IntSort>(_expr.sort);
+		auto intSort = dynamic_pointer_cast<IntSort>(_expr.sort());
 		smtAssert(intSort, "");
 
-		auto arg = toSExpr(_expr.arguments.front());
+		auto arg = toSExpr(_expr.arguments().front());
 		auto nat = "(bv2nat " + arg + ")";
 
 		if (!intSort->isSigned)
 			return nat;
 
-		auto bvSort = dynamic_pointer_cast<BitVectorSort>(_expr.arguments.front().sort);
+		auto bvSort = dynamic_pointer_cast<BitVectorSort>(_expr.arguments().front().sort());
 		smtAssert(bvSort, "");
 		auto size = to_string(bvSort->size);
 		auto pos = to_string(bvSort->size - 1);
@@ -175,36 +184,36 @@ string SMTLib2Interface::toSExpr(Expression const& _expr)
 			nat + " " +
 			"(- (bvneg " + arg + "))";
 	}
-	else if (_expr.name == "const_array")
+	else if (_expr.name() == "const_array")
 	{
-		smtAssert(_expr.arguments.size() == 2, "");
-		auto sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments.at(0).sort);
+		smtAssert(_expr.arguments().size() == 2, "");
+		auto sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments().at(0).sort());
 		smtAssert(sortSort, "");
 		auto arraySort = dynamic_pointer_cast<ArraySort>(sortSort->inner);
 		smtAssert(arraySort, "");
 		sexpr += "(as const " + toSmtLibSort(*arraySort) + ") ";
-		sexpr += toSExpr(_expr.arguments.at(1));
+		sexpr += toSExpr(_expr.arguments().at(1));
 	}
-	else if (_expr.name == "tuple_get")
+	else if (_expr.name() == "tuple_get")
 	{
-		smtAssert(_expr.arguments.size() == 2, "");
-		auto tupleSort = dynamic_pointer_cast<TupleSort>(_expr.arguments.at(0).sort);
-		size_t index = std::stoul(_expr.arguments.at(1).name);
+		smtAssert(_expr.arguments().size() == 2, "");
+		auto tupleSort = dynamic_pointer_cast<TupleSort>(_expr.arguments().at(0).sort());
+		size_t index = std::stoul(_expr.arguments().at(1).name());
 		smtAssert(index < tupleSort->members.size(), "");
-		sexpr += "|" + tupleSort->members.at(index) + "| " + toSExpr(_expr.arguments.at(0));
+		sexpr += "|" + tupleSort->members.at(index) + "| " + toSExpr(_expr.arguments().at(0));
 	}
-	else if (_expr.name == "tuple_constructor")
+	else if (_expr.name() == "tuple_constructor")
 	{
-		auto tupleSort = dynamic_pointer_cast<TupleSort>(_expr.sort);
+		auto tupleSort = dynamic_pointer_cast<TupleSort>(_expr.sort());
 		smtAssert(tupleSort, "");
 		sexpr += "|" + tupleSort->name + "|";
-		for (auto const& arg: _expr.arguments)
+		for (auto const& arg: _expr.arguments())
 			sexpr += " " + toSExpr(arg);
 	}
 	else
 	{
-		sexpr += _expr.name;
-		for (auto const& arg: _expr.arguments)
+		sexpr += _expr.name();
+		for (auto const& arg: _expr.arguments())
 			sexpr += " " + toSExpr(arg);
 	}
 	sexpr += ")";
@@ -275,8 +284,8 @@ string SMTLib2Interface::checkSatAndGetValuesCommand(vector<Expression> const& _
 		for (size_t i = 0; i < _expressionsToEvaluate.size(); i++)
 		{
 			auto const& e = _expressionsToEvaluate.at(i);
-			smtAssert(e.sort->kind == Kind::Int || e.sort->kind == Kind::Bool, "Invalid sort for expression to evaluate.");
-			command += "(declare-const |EVALEXPR_" + to_string(i) + "| " + (e.sort->kind == Kind::Int ? "Int" : "Bool") + ")\n";
+			smtAssert(e.sort()->kind == Kind::Int || e.sort()->kind == Kind::Bool, "Invalid sort for expression to evaluate.");
+			command += "(declare-const |EVALEXPR_" + to_string(i) + "| " + (e.sort()->kind == Kind::Int ? "Int" : "Bool") + ")\n";
 			command += "(assert (= |EVALEXPR_" + to_string(i) + "| " + toSExpr(e) + "))\n";
 		}
 		command += "(check-sat)\n";
@@ -30,6 +30,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace solidity::smtutil
@@ -68,6 +69,10 @@ private:
 
 	void write(std::string _data);
 
+	/// @returns the s-expression of @a _expr, which has to have arguments,
+	/// without consulting the cache of translated expressions.
+	std::string translate(Expression const& _expr);
+
 	std::string checkSatAndGetValuesCommand(std::vector<Expression> const& _expressionsToEvaluate);
 	std::vector<std::string> parseValues(std::string::const_iterator _start, std::string::const_iterator _end);
 
@@ -77,6 +82,8 @@ private:
 	std::vector<std::string> m_accumulatedOutput;
 	std::map<std::string, SortPointer> m_variables;
 	std::set<std::string> m_userSorts;
+	/// S-expressions of the translated expressions with arguments, by expression id.
+	std::unordered_map<size_t, std::string> m_sexprs;
 
 	std::map<util::h256, std::string> m_queryResponses;
 	std::vector<std::string> m_unhandledQueries;
@@ -0,0 +1,144 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <mutex>
+#include <typeinfo>
+#include <unordered_map>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::smtutil;
+
+namespace
+{
+
+/// Table of all live expression nodes, indexed by their structural hash.
+/// Nodes remove themselves from the table when they are destroyed.
+struct NodeTable
+{
+	mutex lock;
+	unordered_multimap<size_t, void const*> nodes;
+	size_t nextId = 0;
+};
+
+NodeTable& nodeTable()
+{
+	// Never destroyed, since expressions with static storage duration might outlive it otherwise.
+	static NodeTable* table = new NodeTable();
+	return *table;
+}
+
+/// @returns true if the sorts are identical. In contrast to ``Sort::operator==``,
+/// this also compares the signedness of integers and the size of bit vectors.
+bool identical(SortPointer const& _a, SortPointer const& _b);
+
+bool identical(vector<SortPointer> const& _a, vector<SortPointer> const& _b)
+{
+	if (_a.size() != _b.size())
+		return false;
+	for (size_t i = 0; i < _a.size(); ++i)
+		if (!identical(_a[i], _b[i]))
+			return false;
+	return true;
+}
+
+bool identical(SortPointer const& _a, SortPointer const& _b)
+{
+	if (_a == _b)
+		return true;
+	if (!_a || !_b || _a->kind != _b->kind || typeid(*_a) != typeid(*_b))
+		return false;
+	if (auto intSort = dynamic_cast<IntSort const*>(_a.get()))
+		return intSort->isSigned == dynamic_cast<IntSort const&>(*_b).isSigned;
+	if (auto bvSort = dynamic_cast<BitVectorSort const*>(_a.get()))
+		return bvSort->size == dynamic_cast<BitVectorSort const&>(*_b).size;
+	if (auto functionSort = dynamic_cast<FunctionSort const*>(_a.get()))
+	{
+		auto const& other = dynamic_cast<FunctionSort const&>(*_b);
+		return identical(functionSort->domain, other.domain) && identical(functionSort->codomain, other.codomain);
+	}
+	if (auto arraySort = dynamic_cast<ArraySort const*>(_a.get()))
+	{
+		auto const& other = dynamic_cast<ArraySort const&>(*_b);
+		return identical(arraySort->domain, other.domain) && identical(arraySort->range, other.range);
+	}
+	if (auto sortSort = dynamic_cast<SortSort const*>(_a.get()))
+		return identical(sortSort->inner, dynamic_cast<SortSort const&>(*_b).inner);
+	if (auto tupleSort = dynamic_cast<TupleSort const*>(_a.get()))
+	{
+		auto const& other = dynamic_cast<TupleSort const&>(*_b);
+		return
+			tupleSort->name == other.name &&
+			tupleSort->members == other.members &&
+			identical(tupleSort->components, other.components);
+	}
+	return true;
+}
+
+}
+
+shared_ptr<Expression::Node const> Expression::node(string _name, vector<Expression> _arguments, SortPointer _sort)
+{
+	size_t hash = std::hash<string>{}(_name);
+	for (Expression const& argument: _arguments)
+		boost::hash_combine(hash, argument.id());
+	if (_sort)
+		boost::hash_combine(hash, static_cast<int>(_sort->kind));
+
+	NodeTable& table = nodeTable();
+	lock_guard<mutex> guard(table.lock);
+	auto [begin, end] = table.nodes.equal_range(hash);
+	for (auto it = begin; it != end; ++it)
+	{
+		Node const& candidate = *static_cast<Node const*>(it->second);
+		if (
+			candidate.name != _name ||
+			candidate.arguments.size() != _arguments.size() ||
+			!identical(candidate.sort, _sort)
+		)
+			continue;
+		bool sameArguments = true;
+		for (size_t i = 0; i < _arguments.size() && sameArguments; ++i)
+			sameArguments = candidate.arguments[i].id() == _arguments[i].id();
+		if (!sameArguments)
+			continue;
+		// The candidate might already be in the process of being destroyed.
+		if (shared_ptr<Node const> existing = candidate.weak_from_this().lock())
+			return existing;
+	}
+	auto created = make_shared<Node const>(move(_name), move(_arguments), move(_sort), hash, table.nextId++);
+	table.nodes.emplace(hash, created.get());
+	return created;
+}
+
+Expression::Node::~Node()
+{
+	NodeTable& table = nodeTable();
+	lock_guard<mutex> guard(table.lock);
+	auto [begin, end] = table.nodes.equal_range(hash);
+	for (auto it = begin; it != end; ++it)
+		if (it->second == this)
+		{
+			table.nodes.erase(it);
+			break;
+		}
+}
@@ -55,6 +55,10 @@ enum class CheckResult
 };
 
 /// C++ representation of an SMTLIB2 expression.
+/// Expressions are immutable and hash-consed: structurally equal expressions share the
+/// same reference-counted node, so copying an expression does not copy its subterms and
+/// the expressions form a DAG. This allows solver interfaces to cache the translation
+/// of subterms by the identity of their node, see id().
 class Expression
 {
 	friend class SolverInterface;
@@ -62,7 +66,7 @@ public:
 	explicit Expression(bool _v): Expression(_v ? "true" : "false", Kind::Bool) {}
 	explicit Expression(std::shared_ptr<SortSort> _sort, std::string _name = ""): Expression(std::move(_name), {}, _sort) {}
 	explicit Expression(std::string _name, std::vector<Expression> _arguments, SortPointer _sort):
-		name(std::move(_name)), arguments(std::move(_arguments)), sort(std::move(_sort)) {}
+		m_node(node(std::move(_name), std::move(_arguments), std::move(_sort))) {}
 	Expression(size_t _number): Expression(std::to_string(_number), {}, SortProvider::sintSort) {}
 	Expression(u256 const& _number): Expression(_number.str(), {}, SortProvider::sintSort) {}
 	Expression(s256 const& _number): Expression(_number.str(), {}, SortProvider::sintSort) {}
@@ -73,13 +77,20 @@ public:
 	Expression& operator=(Expression const&) = default;
 	Expression& operator=(Expression&&) = default;
 
+	std::string const& name() const;
+	std::vector<Expression> const& arguments() const;
+	SortPointer const& sort() const;
+	/// @returns an identifier of the node of this expression. Two expressions have the
+	/// same identifier if and only if they are structurally equal. Identifiers are never reused.
+	size_t id() const;
+
 	bool hasCorrectArity() const
 	{
-		if (name == "tuple_constructor")
+		if (name() == "tuple_constructor")
 		{
-			auto tupleSort = std::dynamic_pointer_cast<TupleSort>(sort);
+			auto tupleSort = std::dynamic_pointer_cast<TupleSort>(sort());
 			smtAssert(tupleSort, "");
-			return arguments.size() == tupleSort->components.size();
+			return arguments().size() == tupleSort->components.size();
 		}
 
 		static std::map<std::string, unsigned> const operatorsArity{
@@ -112,13 +123,13 @@ public:
 			{"const_array", 2},
 			{"tuple_get", 2}
 		};
-		return operatorsArity.count(name) && operatorsArity.at(name) == arguments.size();
+		return operatorsArity.count(name()) && operatorsArity.at(name()) == arguments().size();
 	}
 
 	static Expression ite(Expression _condition, Expression _trueValue, Expression _falseValue)
 	{
-		smtAssert(*_trueValue.sort == *_falseValue.sort, "");
-		SortPointer sort = _trueValue.sort;
+		smtAssert(*_trueValue.sort() == *_falseValue.sort(), "");
+		SortPointer sort = _trueValue.sort();
 		return Expression("ite", std::vector<Expression>{
 			std::move(_condition), std::move(_trueValue), std::move(_falseValue)
 		}, std::move(sort));
@@ -137,11 +148,11 @@ public:
 	/// select is the SMT representation of an array index access.
 	static Expression select(Expression _array, Expression _index)
 	{
-		smtAssert(_array.sort->kind == Kind::Array, "");
-		std::shared_ptr<ArraySort> arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort);
+		smtAssert(_array.sort()->kind == Kind::Array, "");
+		std::shared_ptr<ArraySort> arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort());
 		smtAssert(arraySort, "");
-		smtAssert(_index.sort, "");
-		smtAssert(*arraySort->domain == *_index.sort, "");
+		smtAssert(_index.sort(), "");
+		smtAssert(*arraySort->domain == *_index.sort(), "");
 		return Expression(
 			"select",
 			std::vector<Expression>{std::move(_array), std::move(_index)},
@@ -153,12 +164,12 @@ public:
 	/// The function is pure and returns the modified array.
 	static Expression store(Expression _array, Expression _index, Expression _element)
 	{
-		auto arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort);
+		auto arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort());
 		smtAssert(arraySort, "");
-		smtAssert(_index.sort, "");
-		smtAssert(_element.sort, "");
-		smtAssert(*arraySort->domain == *_index.sort, "");
-		smtAssert(*arraySort->range == *_element.sort, "");
+		smtAssert(_index.sort(), "");
+		smtAssert(_element.sort(), "");
+		smtAssert(*arraySort->domain == *_index.sort(), "");
+		smtAssert(*arraySort->range == *_element.sort(), "");
 		return Expression(
 			"store",
 			std::vector<Expression>{std::move(_array), std::move(_index), std::move(_element)},
@@ -168,12 +179,12 @@ public:
 
 	static Expression const_array(Expression _sort, Expression _value)
 	{
-		smtAssert(_sort.sort->kind == Kind::Sort, "");
-		auto sortSort = std::dynamic_pointer_cast<SortSort>(_sort.sort);
+		smtAssert(_sort.sort()->kind == Kind::Sort, "");
+		auto sortSort = std::dynamic_pointer_cast<SortSort>(_sort.sort());
 		auto arraySort = std::dynamic_pointer_cast<ArraySort>(sortSort->inner);
 		smtAssert(sortSort && arraySort, "");
-		smtAssert(_value.sort, "");
-		smtAssert(*arraySort->range == *_value.sort, "");
+		smtAssert(_value.sort(), "");
+		smtAssert(*arraySort->range == *_value.sort(), "");
 		return Expression(
 			"const_array",
 			std::vector<Expression>{std::move(_sort), std::move(_value)},
@@ -183,8 +194,8 @@ public:
 
 	static Expression tuple_get(Expression _tuple, size_t _index)
 	{
-		smtAssert(_tuple.sort->kind == Kind::Tuple, "");
-		std::shared_ptr<TupleSort> tupleSort = std::dynamic_pointer_cast<TupleSort>(_tuple.sort);
+		smtAssert(_tuple.sort()->kind == Kind::Tuple, "");
+		std::shared_ptr<TupleSort> tupleSort = std::dynamic_pointer_cast<TupleSort>(_tuple.sort());
 		smtAssert(tupleSort, "");
 		smtAssert(_index < tupleSort->components.size(), "");
 		return Expression(
@@ -196,8 +207,8 @@ public:
 
 	static Expression tuple_constructor(Expression _tuple, std::vector<Expression> _arguments)
 	{
-		smtAssert(_tuple.sort->kind == Kind::Sort, "");
-		auto sortSort = std::dynamic_pointer_cast<SortSort>(_tuple.sort);
+		smtAssert(_tuple.sort()->kind == Kind::Sort, "");
+		auto sortSort = std::dynamic_pointer_cast<SortSort>(_tuple.sort());
 		auto tupleSort = std::dynamic_pointer_cast<TupleSort>(sortSort->inner);
 		smtAssert(tupleSort, "");
 		smtAssert(_arguments.size() == tupleSort->components.size(), "");
@@ -210,8 +221,8 @@ public:
 
 	static Expression int2bv(Expression _n, size_t _size)
 	{
-		smtAssert(_n.sort->kind == Kind::Int, "");
-		std::shared_ptr<IntSort> intSort = std::dynamic_pointer_cast<IntSort>(_n.sort);
+		smtAssert(_n.sort()->kind == Kind::Int, "");
+		std::shared_ptr<IntSort> intSort = std::dynamic_pointer_cast<IntSort>(_n.sort());
 		smtAssert(intSort, "");
 		smtAssert(_size <= 256, "");
 		return Expression(
@@ -223,8 +234,8 @@ public:
 
 	static Expression bv2int(Expression _bv, bool _signed = false)
 	{
-		smtAssert(_bv.sort->kind == Kind::BitVector, "");
-		std::shared_ptr<BitVectorSort> bvSort = std::dynamic_pointer_cast<BitVectorSort>(_bv.sort);
+		smtAssert(_bv.sort()->kind == Kind::BitVector, "");
+		std::shared_ptr<BitVectorSort> bvSort = std::dynamic_pointer_cast<BitVectorSort>(_bv.sort());
 		smtAssert(bvSort, "");
 		smtAssert(bvSort->size <= 256, "");
 		return Expression(
@@ -236,24 +247,24 @@ public:
 
 	friend Expression operator!(Expression _a)
 	{
-		if (_a.sort->kind == Kind::BitVector)
+		if (_a.sort()->kind == Kind::BitVector)
 			return ~_a;
 		return Expression("not", std::move(_a), Kind::Bool);
 	}
 	friend Expression operator&&(Expression _a, Expression _b)
 	{
-		if (_a.sort->kind == Kind::BitVector)
+		if (_a.sort()->kind == Kind::BitVector)
 		{
-			smtAssert(_b.sort->kind == Kind::BitVector, "");
+			smtAssert(_b.sort()->kind == Kind::BitVector, "");
 			return _a & _b;
 		}
 		return Expression("and", std::move(_a), std::move(_b), Kind::Bool);
 	}
 	friend Expression operator||(Expression _a, Expression _b)
 	{
-		if (_a.sort->kind == Kind::BitVector)
+		if (_a.sort()->kind == Kind::BitVector)
 		{
-			smtAssert(_b.sort->kind == Kind::BitVector, "");
+			smtAssert(_b.sort()->kind == Kind::BitVector, "");
 			return _a | _b;
 		}
 		return Expression("or", std::move(_a), std::move(_b), Kind::Bool);
@@ -284,80 +295,81 @@ public:
 	}
 	friend Expression operator+(Expression _a, Expression _b)
 	{
-		auto intSort = _a.sort;
+		auto intSort = _a.sort();
 		return Expression("+", {std::move(_a), std::move(_b)}, intSort);
 	}
 	friend Expression operator-(Expression _a, Expression _b)
 	{
-		auto intSort = _a.sort;
+		auto intSort = _a.sort();
 		return Expression("-", {std::move(_a), std::move(_b)}, intSort);
 	}
 	friend Expression operator*(Expression _a, Expression _b)
 	{
-		auto intSort = _a.sort;
+		auto intSort = _a.sort();
 		return Expression("*", {std::move(_a), std::move(_b)}, intSort);
 	}
 	friend Expression operator/(Expression _a, Expression _b)
 	{
-		auto intSort = _a.sort;
+		auto intSort = _a.sort();
 		return Expression("/", {std::move(_a), std::move(_b)}, intSort);
 	}
 	friend Expression operator%(Expression _a, Expression _b)
 	{
-		auto intSort = _a.sort;
+		auto intSort = _a.sort();
 		return Expression("mod", {std::move(_a), std::move(_b)}, intSort);
 	}
 	friend Expression operator~(Expression _a)
 	{
-		auto bvSort = _a.sort;
+		auto bvSort = _a.sort();
 		return Expression("bvnot", {std::move(_a)}, bvSort);
 	}
 	friend Expression operator&(Expression _a, Expression _b)
 	{
-		auto bvSort = _a.sort;
+		auto bvSort = _a.sort();
 		return Expression("bvand", {std::move(_a), std::move(_b)}, bvSort);
 	}
 	friend Expression operator|(Expression _a, Expression _b)
 	{
-		auto bvSort = _a.sort;
+		auto bvSort = _a.sort();
 		return Expression("bvor", {std::move(_a), std::move(_b)}, bvSort);
 	}
 	friend Expression operator^(Expression _a, Expression _b)
 	{
-		auto bvSort = _a.sort;
+		auto bvSort = _a.sort();
 		return Expression("bvxor", {std::move(_a), std::move(_b)}, bvSort);
 	}
 	friend Expression operator<<(Expression _a, Expression _b)
 	{
-		auto bvSort = _a.sort;
+		auto bvSort = _a.sort();
 		return Expression("bvshl", {std::move(_a), std::move(_b)}, bvSort);
 	}
 	friend Expression operator>>(Expression _a, Expression _b)
 	{
-		auto bvSort = _a.sort;
+		auto bvSort = _a.sort();
 		return Expression("bvlshr", {std::move(_a), std::move(_b)}, bvSort);
 	}
 	static Expression ashr(Expression _a, Expression _b)
 	{
-		auto bvSort = _a.sort;
+		auto bvSort = _a.sort();
 		return Expression("bvashr", {std::move(_a), std::move(_b)}, bvSort);
 	}
 	Expression operator()(std::vector<Expression> _arguments) const
 	{
 		smtAssert(
-			sort->kind == Kind::Function,
+			sort()->kind == Kind::Function,
 			"Attempted function application to non-function."
 		);
-		auto fSort = dynamic_cast<FunctionSort const*>(sort.get());
+		auto fSort = dynamic_cast<FunctionSort const*>(sort().get());
 		smtAssert(fSort, "");
-		return Expression(name, std::move(_arguments), fSort->codomain);
+		return Expression(name(), std::move(_arguments), fSort->codomain);
 	}
 
-	std::string name;
-	std::vector<Expression> arguments;
-	SortPointer sort;
-
 private:
+	struct Node;
+	/// @returns the unique node with the given name, arguments and sort,
+	/// creating it if it does not exist yet.
+	static std::shared_ptr<Node const> node(std::string _name, std::vector<Expression> _arguments, SortPointer _sort);
+
 	/// Manual constructors, should only be used by SolverInterface and this class itself.
 	Expression(std::string _name, std::vector<Expression> _arguments, Kind _kind):
 		Expression(std::move(_name), std::move(_arguments), std::make_shared<Sort>(_kind)) {}
@@ -368,8 +380,29 @@ private:
 		Expression(std::move(_name), std::vector<Expression>{std::move(_arg)}, _kind) {}
 	Expression(std::string _name, Expression _arg1, Expression _arg2, Kind _kind):
 		Expression(std::move(_name), std::vector<Expression>{std::move(_arg1), std::move(_arg2)}, _kind) {}
+
+	std::shared_ptr<Node const> m_node;
 };
 
+struct Expression::Node: std::enable_shared_from_this<Node>
+{
+	Node(std::string _name, std::vector<Expression> _arguments, SortPointer _sort, size_t _hash, size_t _id):
+		name(std::move(_name)), arguments(std::move(_arguments)), sort(std::move(_sort)), hash(_hash), id(_id) {}
+	/// Removes the node from the table of unique nodes.
+	~Node();
+
+	std::string const name;
+	std::vector<Expression> const arguments;
+	SortPointer const sort;
+	size_t const hash;
+	size_t const id;
+};
+
+inline std::string const& Expression::name() const { return m_node->name; }
+inline std::vector<Expression> const& Expression::arguments() const { return m_node->arguments; }
+inline SortPointer const& Expression::sort() const { return m_node->sort; }
+inline size_t Expression::id() const { return m_node->id; }
+
 DEV_SIMPLE_EXCEPTION(SolverError);
 
 class SolverInterface
@@ -44,6 +44,7 @@ void Z3Interface::reset()
 {
 	m_constants.clear();
 	m_functions.clear();
+	m_exprs.clear();
 	m_solver.reset();
 }
 
@@ -63,7 +64,13 @@ void Z3Interface::declareVariable(string const& _name, SortPointer const& _sort)
 	if (_sort->kind == Kind::Function)
 		declareFunction(_name, *_sort);
 	else if (m_constants.count(_name))
-		m_constants.at(_name) = m_context.constant(_name.c_str(), z3Sort(*_sort));
+	{
+		z3::expr constant = m_context.constant(_name.c_str(), z3Sort(*_sort));
+		// Cached translations refer to the previous declaration.
+		if (!z3::eq(constant, m_constants.at(_name)))
+			m_exprs.clear();
+		m_constants.at(_name) = constant;
+	}
 	else
 		m_constants.emplace(_name, m_context.constant(_name.c_str(), z3Sort(*_sort)));
 }
@@ -73,7 +80,13 @@ void Z3Interface::declareFunction(string const& _name, Sort const& _sort)
 	smtAssert(_sort.kind == Kind::Function, "");
 	FunctionSort fSort = dynamic_cast<FunctionSort const&>(_sort);
 	if (m_functions.count(_name))
-		m_functions.at(_name) = m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain));
+	{
+		z3::func_decl function = m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain));
+		// Cached translations refer to the previous declaration.
+		if (!z3::eq(function, m_functions.at(_name)))
+			m_exprs.clear();
+		m_functions.at(_name) = function;
+	}
 	else
 		m_functions.emplace(_name, m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain)));
 }
@@ -130,15 +143,26 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
-	if (_expr.arguments.empty() && m_constants.count(_expr.name))
-		return m_constants.at(_expr.name);
+	if (_expr.arguments().empty())
+		return translate(_expr);
+
+	auto it = m_exprs.find(_expr.id());
+	if (it == m_exprs.end())
+		it = m_exprs.emplace(_expr.id(), translate(_expr)).first;
+	return it->second;
+}
+
+z3::expr Z3Interface::translate(Expression const& _expr)
+{
+	if (_expr.arguments().empty() && m_constants.count(_expr.name()))
+		return m_constants.at(_expr.name());
 	z3::expr_vector arguments(m_context);
-	for (auto const& arg: _expr.arguments)
+	for (auto const& arg: _expr.arguments())
 		arguments.push_back(toZ3Expr(arg));
 
 	try
 	{
-		string const& n = _expr.name;
+		string const& n = _expr.name();
 		if (m_functions.count(n))
 			return m_functions.at(n)(arguments);
 		else if (m_constants.count(n))
@@ -152,9 +176,9 @@ z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 				return m_context.bool_val(true);
 			else if (n == "false")
 				return m_context.bool_val(false);
-			else if (_expr.sort->kind == Kind::Sort)
+			else if (_expr.sort()->kind == Kind::Sort)
 			{
-				auto sortSort = dynamic_pointer_cast<SortSort>(_expr.sort);
+				auto sortSort = dynamic_pointer_cast<SortSort>(_expr.sort());
 				smtAssert(sortSort, "");
 				return m_context.constant(n.c_str(), z3Sort(*sortSort->inner));
 			}
@@ -216,12 +240,12 @@ z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 			return z3::ashr(arguments[0], arguments[1]);
 		else if (n == "int2bv")
 		{
-			size_t size = std::stoul(_expr.arguments[1].name);
+			size_t size = std::stoul(_expr.arguments()[1].name());
 			return z3::int2bv(static_cast<unsigned>(size), arguments[0]);
 		}
 		else if (n == "bv2int")
 		{
-			auto intSort = dynamic_pointer_cast<IntSort>(_expr.sort);
+			auto intSort = dynamic_pointer_cast<IntSort>(_expr.sort());
 			smtAssert(intSort, "");
 			return z3::bv2int(arguments[0], intSort->isSigned);
 		}
@@ -231,7 +255,7 @@ z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 			return z3::store(arguments[0], arguments[1], arguments[2]);
 		else if (n == "const_array")
 		{
-			shared_ptr<SortSort> sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments[0].sort);
+			shared_ptr<SortSort> sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments()[0].sort());
 			smtAssert(sortSort, "");
 			auto arraySort = dynamic_pointer_cast<ArraySort>(sortSort->inner);
 			smtAssert(arraySort && arraySort->domain, "");
@@ -239,12 +263,12 @@ z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 		}
 		else if (n == "tuple_get")
 		{
-			size_t index = stoul(_expr.arguments[1].name);
-			return z3::func_decl(m_context, Z3_get_tuple_sort_field_decl(m_context, z3Sort(*_expr.arguments[0].sort), static_cast<unsigned>(index)))(arguments[0]);
+			size_t index = stoul(_expr.arguments()[1].name());
+			return z3::func_decl(m_context, Z3_get_tuple_sort_field_decl(m_context, z3Sort(*_expr.arguments()[0].sort()), static_cast<unsigned>(index)))(arguments[0]);
 		}
 		else if (n == "tuple_constructor")
 		{
-			auto constructor = z3::func_decl(m_context, Z3_get_tuple_sort_mk_decl(m_context, z3Sort(*_expr.sort)));
+			auto constructor = z3::func_decl(m_context, Z3_get_tuple_sort_mk_decl(m_context, z3Sort(*_expr.sort())));
 			smtAssert(constructor.arity() == arguments.size(), "");
 			z3::expr_vector args(m_context);
 			for (auto const& arg: arguments)
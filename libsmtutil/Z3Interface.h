@@ -21,6 +21,7 @@
 #include <libsmtutil/SolverInterface.h>
 #include <boost/noncopyable.hpp>
 #include <z3++.h>
+#include <unordered_map>
 
 namespace solidity::smtutil
 {
@@ -55,6 +56,9 @@ public:
 private:
 	void declareFunction(std::string const& _name, Sort const& _sort);
 
+	/// @returns the Z3 expression for @a _expr without consulting the cache of translated expressions.
+	z3::expr translate(Expression const& _expr);
+
 	z3::sort z3Sort(Sort const& _sort);
 	z3::sort_vector z3Sort(std::vector<SortPointer> const& _sorts);
 	smtutil::SortPointer fromZ3Sort(z3::sort const& _sort);
@@ -65,6 +69,8 @@ private:
 
 	std::map<std::string, z3::expr> m_constants;
 	std::map<std::string, z3::func_decl> m_functions;
+	/// Translations of the expressions with arguments, by expression id.
+	std::unordered_map<size_t, z3::expr> m_exprs;
 };
 
 }
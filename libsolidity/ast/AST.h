@@ -126,7 +126,7 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	size_t m_id = 0;
 
 	template <class T>
 	T& initAnnotation() const
@@ -137,6 +137,9 @@ protected:
 	}
 
 private:
+	/// The parser renumbers nodes of source units that were parsed separately.
+	friend class Parser;
+
 	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism).
 	mutable std::unique_ptr<ASTAnnotation> m_annotation;
 	SourceLocation m_location;
@@ -1372,6 +1375,9 @@ public:
 	BlockAnnotation& annotation() const override;
 
 private:
+	/// The parser fills in the statements of function bodies whose parsing was deferred.
+	friend class Parser;
+
 	std::vector<ASTPointer<Statement>> m_statements;
 };
 
@@ -234,7 +234,53 @@ Json::Value ASTJsonConverter::inlineAssemblyIdentifierToJson(pair<yul::Identifie
 
 void ASTJsonConverter::print(ostream& _stream, ASTNode const& _node)
 {
-	_stream << util::jsonPrettyPrint(toJson(_node));
+	util::JsonStreamWriter writer(_stream, true);
+	print(writer, _node);
+}
+
+void ASTJsonConverter::print(util::JsonStreamWriter& _writer, ASTNode const& _node)
+{
+	auto const* sourceUnit = dynamic_cast<SourceUnit const*>(&_node);
+	auto const* contract = dynamic_cast<ContractDefinition const*>(&_node);
+	// The legacy format moves the nodes into "children", so it is not streamed.
+	if (m_legacy || (!sourceUnit && !contract))
+	{
+		_writer.value(toJson(_node));
+		return;
+	}
+	vector<ASTPointer<ASTNode>> const subNodes = sourceUnit ? sourceUnit->nodes() : contract->subNodes();
+
+	m_streamedNode = &_node;
+	Json::Value json = toJson(_node);
+	m_streamedNode = nullptr;
+
+	auto writeNodes = [&]() {
+		_writer.key("nodes");
+		_writer.beginArray();
+		for (auto const& subNode: subNodes)
+			if (subNode)
+				print(_writer, *subNode);
+			else
+				_writer.value(Json::nullValue);
+		_writer.endArray();
+	};
+
+	// Members have to be written in the same order as Json::Value stores them.
+	bool nodesWritten = false;
+	_writer.beginObject();
+	for (string const& name: json.getMemberNames())
+	{
+		if (!nodesWritten && name > "nodes")
+		{
+			writeNodes();
+			nodesWritten = true;
+		}
+		_writer.key(name);
+		_writer.value(json[name]);
+	}
+	if (!nodesWritten)
+		writeNodes();
+	_writer.endObject();
 }
 
 Json::Value ASTJsonConverter::toJson(ASTNode const& _node)
@@ -247,7 +293,7 @@ bool ASTJsonConverter::visit(SourceUnit const& _node)
 {
 	std::vector<pair<string, Json::Value>> attributes = {
 		make_pair("license", _node.licenseString() ? Json::Value(*_node.licenseString()) : Json::nullValue),
-		make_pair("nodes", toJson(_node.nodes()))
+		make_pair("nodes", &_node == m_streamedNode ? Json::nullValue : toJson(_node.nodes()))
 	};
 
 	if (_node.annotation().exportedSymbols.set())
@@ -315,7 +361,7 @@ bool ASTJsonConverter::visit(ContractDefinition const& _node)
 		make_pair("abstract", _node.abstract()),
 		make_pair("baseContracts", toJson(_node.baseContracts())),
 		make_pair("contractDependencies", getContainerIds(_node.annotation().contractDependencies, true)),
-		make_pair("nodes", toJson(_node.subNodes())),
+		make_pair("nodes", &_node == m_streamedNode ? Json::nullValue : toJson(_node.subNodes())),
 		make_pair("scope", idOrNull(_node.scope()))
 	};
 
@@ -41,6 +41,11 @@ namespace solidity::langutil
 struct SourceLocation;
 }
 
+namespace solidity::util
+{
+class JsonStreamWriter;
+}
+
 namespace solidity::frontend
 {
 
@@ -61,6 +66,10 @@ public:
 	);
 	/// Output the json representation of the AST to _stream.
 	void print(std::ostream& _stream, ASTNode const& _node);
+	/// Output the json representation of the AST to _writer. The nodes of source units and
+	/// contracts are converted and written one at a time, so that the complete tree
+	/// never has to be held as a Json::Value.
+	void print(util::JsonStreamWriter& _writer, ASTNode const& _node);
 	Json::Value toJson(ASTNode const& _node);
 	template <class T>
 	Json::Value toJson(std::vector<ASTPointer<T>> const& _nodes)
@@ -195,6 +204,8 @@ private:
 	CompilerStack::State m_stackState = CompilerStack::State::Empty; ///< Used to only access information that already exists
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
 	Json::Value m_currentValue;
+	/// Node whose "nodes" member is omitted by the visitor because print writes it separately.
+	ASTNode const* m_streamedNode = nullptr;
 	std::map<std::string, unsigned> m_sourceIndices;
 };
 
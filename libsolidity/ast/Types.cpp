@@ -293,15 +293,19 @@ string Type::escapeIdentifier(string const& _identifier)
 	return ret;
 }
 
-string Type::identifier() const
+string const& Type::identifier() const
 {
-	string ret = escapeIdentifier(richIdentifier());
-	solAssert(ret.find_first_of("0123456789") != 0, "Identifier cannot start with a number.");
-	solAssert(
-		ret.find_first_not_of("0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMONPQRSTUVWXYZ_$") == string::npos,
-		"Identifier contains invalid characters."
-	);
-	return ret;
+	if (!m_identifier)
+	{
+		string ret = escapeIdentifier(richIdentifier());
+		solAssert(ret.find_first_of("0123456789") != 0, "Identifier cannot start with a number.");
+		solAssert(
+			ret.find_first_not_of("0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMONPQRSTUVWXYZ_$") == string::npos,
+			"Identifier contains invalid characters."
+		);
+		m_identifier = move(ret);
+	}
+	return *m_identifier;
 }
 
 TypePointer Type::commonType(Type const* _a, Type const* _b)
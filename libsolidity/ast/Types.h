@@ -188,7 +188,8 @@ public:
 	/// only if they have the same identifier.
 	/// The identifier should start with "t_".
 	/// Will not contain any character which would be invalid as an identifier.
-	std::string identifier() const;
+	/// Computed on first use, since types cannot change.
+	std::string const& identifier() const;
 
 	/// More complex identifier strings use "parentheses", where $_ is interpreted as
 	/// "opening parenthesis", _$ as "closing parenthesis", _$_ as "comma" and any $ that
@@ -396,6 +397,7 @@ protected:
 	mutable std::map<ASTNode const*, std::unique_ptr<MemberList>> m_members;
 	mutable std::optional<std::vector<std::tuple<std::string, TypePointer>>> m_stackItems;
 	mutable std::optional<size_t> m_stackSize;
+	mutable std::optional<std::string> m_identifier;
 };
 
 /**
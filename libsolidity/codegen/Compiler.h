@@ -60,7 +60,7 @@ public:
 	/// @returns Only the runtime object (without constructor).
 	evmasm::LinkerObject runtimeObject() const { return m_context.assembledRuntimeObject(m_runtimeSub); }
 	/// @arg _sourceCodes is the map of input files to source code strings
-	std::string assemblyString(StringMap const& _sourceCodes = StringMap()) const
+	std::string assemblyString(SharedStringMap const& _sourceCodes = SharedStringMap()) const
 	{
 		return m_context.assemblyString(_sourceCodes);
 	}
@@ -288,7 +288,7 @@ public:
 	std::shared_ptr<evmasm::Assembly> assemblyPtr() const { return m_asm; }
 
 	/// @arg _sourceCodes is the map of input files to source code strings
-	std::string assemblyString(StringMap const& _sourceCodes = StringMap()) const
+	std::string assemblyString(SharedStringMap const& _sourceCodes = SharedStringMap()) const
 	{
 		return m_asm->assemblyString(_sourceCodes);
 	}
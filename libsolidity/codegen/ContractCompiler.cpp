@@ -388,6 +388,39 @@ bool hasPayableFunctions(ContractDefinition const& _contract)
 	return false;
 }
 
+/// @returns the IDs of the functions that should be dispatched before all others, most
+/// frequently called first. A function is checked up front if it receives at least half of
+/// the remaining calls according to @a _executionCounts, because then the additional
+/// comparison is cheaper on average than searching for it.
+vector<FixedHash<4>> hotFunctionIDs(
+	map<FixedHash<4>, FunctionTypePointer> const& _interfaceFunctions,
+	map<string, size_t> const& _executionCounts
+)
+{
+	vector<pair<size_t, FixedHash<4>>> counts;
+	size_t remainingCalls = 0;
+	for (auto const& [id, function]: _interfaceFunctions)
+	{
+		auto count = _executionCounts.find(function->externalSignature());
+		if (count != _executionCounts.end() && count->second > 0)
+		{
+			counts.emplace_back(count->second, id);
+			remainingCalls += count->second;
+		}
+	}
+	sort(counts.begin(), counts.end(), greater<>());
+
+	vector<FixedHash<4>> ids;
+	for (auto const& [count, id]: counts)
+	{
+		if (count < remainingCalls - count)
+			break;
+		ids.emplace_back(id);
+		remainingCalls -= count;
+	}
+	return ids;
+}
+
 }
 
 void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contract)
@@ -435,6 +468,12 @@ void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contrac
 			callDataUnpackerEntryPoints.emplace(it.first, m_context.newTag());
 			sortedIDs.emplace_back(it.first);
 		}
+		for (FixedHash<4> const& id: hotFunctionIDs(interfaceFunctions, m_optimiserSettings.functionExecutionCounts))
+		{
+			m_context << dupInstruction(1) << u256(FixedHash<4>::Arith(id)) << Instruction::EQ;
+			m_context.appendConditionalJumpTo(callDataUnpackerEntryPoints.at(id));
+			sortedIDs.erase(find(sortedIDs.begin(), sortedIDs.end(), id));
+		}
 		std::sort(sortedIDs.begin(), sortedIDs.end());
 		appendInternalSelector(callDataUnpackerEntryPoints, sortedIDs, notFound, m_optimiserSettings.expectedExecutionsPerDeployment);
 	}
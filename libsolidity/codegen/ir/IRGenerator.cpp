@@ -41,6 +41,7 @@
 
 #include <boost/range/adaptor/map.hpp>
 
+#include <algorithm>
 #include <sstream>
 
 using namespace std;
@@ -647,6 +648,14 @@ string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 		templ["allocate"] = m_utils.allocationFunction();
 		templ["abiEncode"] = abiFunctions.tupleEncoder(type->returnParameterTypes(), type->returnParameterTypes(), false);
 	}
+	// Check frequently called functions first.
+	auto executionCount = [&](map<string, string> const& _function) -> size_t {
+		auto count = m_optimiserSettings.functionExecutionCounts.find(_function.at("functionName"));
+		return count == m_optimiserSettings.functionExecutionCounts.end() ? 0 : count->second;
+	};
+	stable_sort(functions.begin(), functions.end(), [&](auto const& _a, auto const& _b) {
+		return executionCount(_a) > executionCount(_b);
+	});
 	t("cases", functions);
 	if (FunctionDefinition const* fallback = _contract.fallbackFunction())
 	{
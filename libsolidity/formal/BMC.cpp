@@ -842,7 +842,7 @@ void BMC::checkCondition(
 		solAssert(values.size() == expressionNames.size(), "");
 		map<string, string> sortedModel;
 		for (size_t i = 0; i < values.size(); ++i)
-			if (expressionsToEvaluate.at(i).name != values.at(i))
+			if (expressionsToEvaluate.at(i).name() != values.at(i))
 				sortedModel[expressionNames.at(i)] = values.at(i);
 
 		for (auto const& eval: sortedModel)
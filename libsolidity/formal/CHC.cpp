@@ -141,7 +141,7 @@ void CHC::endVisit(ContractDefinition const& _contract)
 	);
 	addRule(
 		(*implicitConstructorPredicate)({0, state().thisAddress(), state().crypto(), state().tx(), state().state()}),
-		implicitConstructorPredicate->functor().name
+		implicitConstructorPredicate->functor().name()
 	);
 	setCurrentBlock(*implicitConstructorPredicate);
 
@@ -192,7 +192,7 @@ bool CHC::visit(FunctionDefinition const& _function)
 	if (_function.isConstructor())
 		connectBlocks(m_currentBlock, functionPred);
 	else
-		addRule(functionPred, functionPred.name);
+		addRule(functionPred, functionPred.name());
 
 	m_context.addAssertion(errorFlag().currentValue() == 0);
 	for (auto const* var: m_stateVariables)
@@ -964,7 +964,7 @@ void CHC::connectBlocks(smtutil::Expression const& _from, smtutil::Expression co
 		_from && m_context.assertions() && _constraints,
 		_to
 	);
-	addRule(edge, _from.name + "_to_" + _to.name);
+	addRule(edge, _from.name() + "_to_" + _to.name());
 }
 
 vector<smtutil::Expression> CHC::initialStateVariables()
@@ -1295,7 +1295,7 @@ void CHC::checkAndReportTarget(
 	{
 		solAssert(!_satMsg.empty(), "");
 		m_unsafeTargets[_target.errorNode].insert(_target.type);
-		auto cex = generateCounterexample(model, error().name);
+		auto cex = generateCounterexample(model, error().name());
 		if (cex)
 			m_errorReporter.warning(
 				_errorReporterId,
@@ -1339,7 +1339,7 @@ optional<string> CHC::generateCounterexample(CHCSolverInterface::CexGraph const&
 {
 	optional<unsigned> rootId;
 	for (auto const& [id, node]: _graph.nodes)
-		if (node.name == _root)
+		if (node.name() == _root)
 		{
 			rootId = id;
 			break;
@@ -1363,18 +1363,18 @@ optional<string> CHC::generateCounterexample(CHCSolverInterface::CexGraph const&
 		if (edges.size() == 2)
 		{
 			interfaceId = edges.at(1);
-			if (!Predicate::predicate(_graph.nodes.at(summaryId).name)->isSummary())
+			if (!Predicate::predicate(_graph.nodes.at(summaryId).name())->isSummary())
 				swap(summaryId, *interfaceId);
-			auto interfacePredicate = Predicate::predicate(_graph.nodes.at(*interfaceId).name);
+			auto interfacePredicate = Predicate::predicate(_graph.nodes.at(*interfaceId).name());
 			solAssert(interfacePredicate && interfacePredicate->isInterface(), "");
 		}
 		/// The children are unordered, so we need to check which is the summary and
 		/// which is the interface.
 
-		Predicate const* summaryPredicate = Predicate::predicate(_graph.nodes.at(summaryId).name);
+		Predicate const* summaryPredicate = Predicate::predicate(_graph.nodes.at(summaryId).name());
 		solAssert(summaryPredicate && summaryPredicate->isSummary(), "");
 		/// At this point property 2 from the function description is verified for this node.
-		vector<smtutil::Expression> summaryArgs = _graph.nodes.at(summaryId).arguments;
+		vector<smtutil::Expression> summaryArgs = _graph.nodes.at(summaryId).arguments();
 
 		FunctionDefinition const* calledFun = summaryPredicate->programFunction();
 		ContractDefinition const* calledContract = summaryPredicate->programContract();
@@ -1420,7 +1420,7 @@ optional<string> CHC::generateCounterexample(CHCSolverInterface::CexGraph const&
 		/// or stop.
 		if (interfaceId)
 		{
-			Predicate const* interfacePredicate = Predicate::predicate(_graph.nodes.at(*interfaceId).name);
+			Predicate const* interfacePredicate = Predicate::predicate(_graph.nodes.at(*interfaceId).name());
 			solAssert(interfacePredicate && interfacePredicate->isInterface(), "");
 			node = *interfaceId;
 		}
@@ -1437,13 +1437,13 @@ string CHC::cex2dot(CHCSolverInterface::CexGraph const& _cex)
 
 	auto pred = [&](CHCSolverInterface::CexNode const& _node) {
 		vector<string> args = applyMap(
-			_node.arguments,
+			_node.arguments(),
 			[&](auto const& arg) {
-				solAssert(arg.arguments.empty(), "");
-				return arg.name;
+				solAssert(arg.arguments().empty(), "");
+				return arg.name();
 			}
 		);
-		return "\"" + _node.name + "(" + boost::algorithm::join(args, ", ") + ")\"";
+		return "\"" + _node.name() + "(" + boost::algorithm::join(args, ", ") + ")\"";
 	};
 
 	for (auto const& [u, vs]: _cex.edges)
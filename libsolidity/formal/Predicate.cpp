@@ -141,12 +141,12 @@ optional<vector<VariableDeclaration const*>> Predicate::stateVariables() const
 
 bool Predicate::isSummary() const
 {
-	return functor().name.rfind("summary", 0) == 0;
+	return functor().name().rfind("summary", 0) == 0;
 }
 
 bool Predicate::isInterface() const
 {
-	return functor().name.rfind("interface", 0) == 0;
+	return functor().name().rfind("interface", 0) == 0;
 }
 
 string Predicate::formatSummaryCall(vector<smtutil::Expression> const& _args) const
@@ -278,31 +278,31 @@ optional<string> Predicate::expressionToString(smtutil::Expression const& _expr,
 {
 	if (smt::isNumber(*_type))
 	{
-		solAssert(_expr.sort->kind == Kind::Int, "");
-		solAssert(_expr.arguments.empty(), "");
-		// TODO assert that _expr.name is a number.
-		return _expr.name;
+		solAssert(_expr.sort()->kind == Kind::Int, "");
+		solAssert(_expr.arguments().empty(), "");
+		// TODO assert that _expr.name() is a number.
+		return _expr.name();
 	}
 	if (smt::isBool(*_type))
 	{
-		solAssert(_expr.sort->kind == Kind::Bool, "");
-		solAssert(_expr.arguments.empty(), "");
-		solAssert(_expr.name == "true" || _expr.name == "false", "");
-		return _expr.name;
+		solAssert(_expr.sort()->kind == Kind::Bool, "");
+		solAssert(_expr.arguments().empty(), "");
+		solAssert(_expr.name() == "true" || _expr.name() == "false", "");
+		return _expr.name();
 	}
 	if (smt::isFunction(*_type))
 	{
-		solAssert(_expr.arguments.empty(), "");
-		return _expr.name;
+		solAssert(_expr.arguments().empty(), "");
+		return _expr.name();
 	}
 	if (smt::isArray(*_type))
 	{
 		auto const& arrayType = dynamic_cast<ArrayType const&>(*_type);
-		solAssert(_expr.name == "tuple_constructor", "");
-		auto const& tupleSort = dynamic_cast<TupleSort const&>(*_expr.sort);
+		solAssert(_expr.name() == "tuple_constructor", "");
+		auto const& tupleSort = dynamic_cast<TupleSort const&>(*_expr.sort());
 		solAssert(tupleSort.components.size() == 2, "");
 
-		auto length = stoul(_expr.arguments.at(1).name);
+		auto length = stoul(_expr.arguments().at(1).name());
 		// Limit this counterexample size to 1k.
 		// Some OSs give you "unlimited" memory through swap and other virtual memory,
 		// so purely relying on bad_alloc being thrown is not a good idea.
@@ -312,7 +312,7 @@ optional<string> Predicate::expressionToString(smtutil::Expression const& _expr,
 		try
 		{
 			vector<string> array(length);
-			if (!fillArray(_expr.arguments.at(0), array, arrayType))
+			if (!fillArray(_expr.arguments().at(0), array, arrayType))
 				return {};
 			return "[" + boost::algorithm::join(array, ", ") + "]";
 		}
@@ -328,10 +328,10 @@ optional<string> Predicate::expressionToString(smtutil::Expression const& _expr,
 bool Predicate::fillArray(smtutil::Expression const& _expr, vector<string>& _array, ArrayType const& _type) const
 {
 	// Base case
-	if (_expr.name == "const_array")
+	if (_expr.name() == "const_array")
 	{
 		auto length = _array.size();
-		optional<string> elemStr = expressionToString(_expr.arguments.at(1), _type.baseType());
+		optional<string> elemStr = expressionToString(_expr.arguments().at(1), _type.baseType());
 		if (!elemStr)
 			return false;
 		_array.clear();
@@ -340,11 +340,11 @@ bool Predicate::fillArray(smtutil::Expression const& _expr, vector<string>& _arr
 	}
 
 	// Recursive case.
-	if (_expr.name == "store")
+	if (_expr.name() == "store")
 	{
-		if (!fillArray(_expr.arguments.at(0), _array, _type))
+		if (!fillArray(_expr.arguments().at(0), _array, _type))
 			return false;
-		optional<string> indexStr = expressionToString(_expr.arguments.at(1), TypeProvider::uint256());
+		optional<string> indexStr = expressionToString(_expr.arguments().at(1), TypeProvider::uint256());
 		if (!indexStr)
 			return false;
 		// Sometimes the solver assigns huge lengths that are not related,
@@ -358,7 +358,7 @@ bool Predicate::fillArray(smtutil::Expression const& _expr, vector<string>& _arr
 		{
 			return true;
 		}
-		optional<string> elemStr = expressionToString(_expr.arguments.at(2), _type.baseType());
+		optional<string> elemStr = expressionToString(_expr.arguments().at(2), _type.baseType());
 		if (!elemStr)
 			return false;
 		if (index < _array.size())
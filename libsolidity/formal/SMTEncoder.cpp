@@ -780,7 +780,7 @@ void SMTEncoder::visitCryptoFunction(FunctionCall const& _funCall)
 		auto arg1 = expr(*_funCall.arguments().at(1));
 		auto arg2 = expr(*_funCall.arguments().at(2));
 		auto arg3 = expr(*_funCall.arguments().at(3));
-		auto inputSort = dynamic_cast<smtutil::ArraySort&>(*e.sort).domain;
+		auto inputSort = dynamic_cast<smtutil::ArraySort&>(*e.sort()).domain;
 		auto ecrecoverInput = smtutil::Expression::tuple_constructor(
 			smtutil::Expression(make_shared<smtutil::SortSort>(inputSort), ""),
 			{arg0, arg1, arg2, arg3}
@@ -1897,7 +1897,7 @@ void SMTEncoder::tupleAssignment(Expression const& _left, Expression const& _rig
 		solAssert(lComponents.size() == rComponents.size(), "");
 
 		auto symbRight = expr(*right);
-		solAssert(symbRight.sort->kind == smtutil::Kind::Tuple, "");
+		solAssert(symbRight.sort()->kind == smtutil::Kind::Tuple, "");
 
 		for (unsigned i = 0; i < lComponents.size(); ++i)
 			if (auto component = lComponents.at(i); component && rComponents.at(i))
@@ -2230,7 +2230,7 @@ void SMTEncoder::createExpr(Expression const& _e)
 void SMTEncoder::defineExpr(Expression const& _e, smtutil::Expression _value)
 {
 	createExpr(_e);
-	solAssert(_value.sort->kind != smtutil::Kind::Function, "Equality operator applied to type that is not fully supported");
+	solAssert(_value.sort()->kind != smtutil::Kind::Function, "Equality operator applied to type that is not fully supported");
 	m_context.addAssertion(expr(_e) == _value);
 }
 
@@ -65,7 +65,7 @@ smtutil::Expression BlockchainVariable::assignMember(string const& _member, smtu
 			args.emplace_back(member(m.first));
 	m_tuple->increaseIndex();
 	auto tuple = m_tuple->currentValue();
-	auto sortExpr = smtutil::Expression(make_shared<smtutil::SortSort>(tuple.sort), tuple.name);
+	auto sortExpr = smtutil::Expression(make_shared<smtutil::SortSort>(tuple.sort()), tuple.name());
 	m_context.addAssertion(tuple == smtutil::Expression::tuple_constructor(sortExpr, args));
 	return m_tuple->currentValue();
 }
@@ -69,6 +69,7 @@
 #include <libsolutil/SwarmHash.h>
 #include <libsolutil/IpfsHash.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Parallel.h>
 
 #include <json/json.h>
 
@@ -234,24 +235,45 @@ void CompilerStack::reset(bool _keepSettings)
 	}
 	m_globalContext.reset();
 	m_sourceOrder.clear();
+	m_deferredSources.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
 	TypeProvider::reset();
 }
 
 void CompilerStack::setSources(StringMap _sources)
+{
+	SharedStringMap sources;
+	for (auto& source: _sources)
+		sources[source.first] = make_shared<string const>(std::move(source.second));
+	setSources(std::move(sources));
+}
+
+void CompilerStack::setSources(SharedStringMap _sources)
 {
 	if (m_stackState == SourcesSet)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot change sources once set."));
 	if (m_stackState != Empty)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set sources before parsing."));
-	for (auto source: _sources)
+	for (auto& source: _sources)
 		m_sources[source.first].scanner = make_shared<Scanner>(CharStream(/*content*/std::move(source.second), /*name*/source.first));
 	m_stackState = SourcesSet;
 }
 
+/// Parser state of one source. Each source gets its own parser and error list,
+/// so that several sources can be parsed at the same time.
+struct CompilerStack::ParsedSource
+{
+	string path;
+	ErrorList errors;
+	ErrorReporter errorReporter{errors};
+	unique_ptr<Parser> parser;
+	ASTPointer<SourceUnit> ast;
+};
+
 bool CompilerStack::parse()
 {
+	if (getenv("SOLC_LAZY_TEST")) m_lazyFunctionBodies = true; // TEMPHACK
 	if (m_stackState != SourcesSet)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call parse only after the SourcesSet state."));
 	m_errorReporter.clear();
@@ -259,32 +281,61 @@ bool CompilerStack::parse()
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
 
-	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
-
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
 		sourcesToParse.push_back(s.first);
 
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
+	// Sources are parsed in rounds: All sources known at the start of a round are parsed in
+	// parallel. Afterwards, their imports are resolved in order, which yields the sources
+	// of the next round. The resulting order of the sources is the same as when parsing them
+	// one by one, and node IDs and errors are assigned in that order.
+	int64_t nodeIDOffset = 0;
+	for (size_t roundBegin = 0; roundBegin < sourcesToParse.size();)
 	{
-		string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
-		source.scanner->reset();
-		source.ast = parser.parse(source.scanner);
-		if (!source.ast)
-			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
-		else
+		size_t const roundEnd = sourcesToParse.size();
+		vector<shared_ptr<ParsedSource>> parsedSources(roundEnd - roundBegin);
+		util::parallelFor(parsedSources.size(), [&](size_t _index) {
+			parsedSources[_index] = make_shared<ParsedSource>();
+			ParsedSource& parsedSource = *parsedSources[_index];
+			parsedSource.path = sourcesToParse[roundBegin + _index];
+			Source const& source = m_sources.at(parsedSource.path);
+			parsedSource.parser = make_unique<Parser>(
+				parsedSource.errorReporter,
+				m_evmVersion,
+				m_parserErrorRecovery,
+				m_lazyFunctionBodies
+			);
+			source.scanner->reset();
+			parsedSource.ast = parsedSource.parser->parse(source.scanner);
+		});
+
+		for (size_t i = roundBegin; i < roundEnd; ++i)
 		{
-			source.ast->annotation().path = path;
-			if (m_stopAfter >= ParsedAndImported)
-				for (auto const& newSource: loadMissingSources(*source.ast, path))
-				{
-					string const& newPath = newSource.first;
-					string const& newContents = newSource.second;
-					m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
-					sourcesToParse.push_back(newPath);
-				}
+			string const path = sourcesToParse[i];
+			ParsedSource& parsedSource = *parsedSources[i - roundBegin];
+			m_errorReporter.append(parsedSource.errors);
+			parsedSource.parser->shiftNodeIDs(nodeIDOffset);
+			nodeIDOffset += parsedSource.parser->nodeCount();
+
+			Source& source = m_sources[path];
+			source.ast = parsedSource.ast;
+			if (m_lazyFunctionBodies && !m_parserErrorRecovery)
+				m_deferredSources.push_back(parsedSources[i - roundBegin]);
+			if (!source.ast)
+				solAssert(!Error::containsOnlyWarnings(parsedSource.errors), "Parser returned null but did not report error.");
+			else
+			{
+				source.ast->annotation().path = path;
+				if (m_stopAfter >= ParsedAndImported)
+					for (auto& newSource: loadMissingSources(*source.ast, path))
+					{
+						string const& newPath = newSource.first;
+						m_sources[newPath].scanner = make_shared<Scanner>(CharStream(std::move(newSource.second), newPath));
+						sourcesToParse.push_back(newPath);
+					}
+			}
 		}
+		roundBegin = roundEnd;
 	}
 
 	if (m_stopAfter <= Parsed)
@@ -311,7 +362,7 @@ void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 		Source source;
 		source.ast = src.second;
 		string srcString = util::jsonCompactPrint(m_sourceJsons[src.first]);
-		ASTPointer<Scanner> scanner = make_shared<Scanner>(langutil::CharStream(srcString, src.first));
+		ASTPointer<Scanner> scanner = make_shared<Scanner>(langutil::CharStream(std::move(srcString), src.first));
 		source.scanner = scanner;
 		m_sources[path] = source;
 	}
@@ -325,6 +376,11 @@ bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsedAndImported || m_stackState >= AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call analyze only after parsing was performed."));
+	if (!parseDeferredFunctionBodies())
+	{
+		m_hasError = true;
+		return false;
+	}
 	resolveImports();
 
 	for (Source const* source: m_sourceOrder)
@@ -480,6 +536,37 @@ bool CompilerStack::analyze()
 	return !m_hasError;
 }
 
+bool CompilerStack::parseDeferredFunctionBodies()
+{
+	if (m_deferredSources.empty())
+		return true;
+
+	util::parallelFor(m_deferredSources.size(), [&](size_t _index) {
+		ParsedSource& parsedSource = *m_deferredSources[_index];
+		// Errors of the first pass have been reported already.
+		parsedSource.errors.clear();
+		if (parsedSource.ast && !parsedSource.parser->parseDeferredFunctionBodies())
+			parsedSource.ast = nullptr;
+	});
+
+	// Sources are numbered in the same order as in parse().
+	bool success = true;
+	int64_t nodeIDOffset = 0;
+	for (shared_ptr<ParsedSource> const& parsedSource: m_deferredSources)
+	{
+		if (!Error::containsOnlyWarnings(parsedSource->errors))
+			success = false;
+		m_errorReporter.append(parsedSource->errors);
+		parsedSource->parser->shiftNodeIDs(nodeIDOffset);
+		nodeIDOffset += parsedSource->parser->nodeCount();
+		if (!parsedSource->ast)
+			m_sources[parsedSource->path].ast = nullptr;
+	}
+	m_deferredSources.clear();
+
+	return success;
+}
+
 bool CompilerStack::parseAndAnalyze(State _stopAfter)
 {
 	m_stopAfter = _stopAfter;
@@ -783,7 +870,7 @@ evmasm::LinkerObject const& CompilerStack::runtimeObject(string const& _contract
 }
 
 /// TODO: cache this string
-string CompilerStack::assemblyString(string const& _contractName, StringMap _sourceCodes) const
+string CompilerStack::assemblyString(string const& _contractName, SharedStringMap const& _sourceCodes) const
 {
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
@@ -1404,6 +1491,7 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 	OptimiserSettings settingsWithoutRuns = m_optimiserSettings;
 	// reset to default
 	settingsWithoutRuns.expectedExecutionsPerDeployment = OptimiserSettings::minimal().expectedExecutionsPerDeployment;
+	settingsWithoutRuns.functionExecutionCounts.clear();
 	if (settingsWithoutRuns == OptimiserSettings::minimal())
 		meta["settings"]["optimizer"]["enabled"] = false;
 	else if (settingsWithoutRuns == OptimiserSettings::standard())
@@ -1423,12 +1511,17 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 		{
 			details["yulDetails"] = Json::objectValue;
 			details["yulDetails"]["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
+			if (m_optimiserSettings.optimizeStackLayout)
+				details["yulDetails"]["stackLayout"] = true;
 			details["yulDetails"]["optimizerSteps"] = m_optimiserSettings.yulOptimiserSteps;
 		}
 
 		meta["settings"]["optimizer"]["details"] = std::move(details);
 	}
 
+	for (auto const& [signature, count]: m_optimiserSettings.functionExecutionCounts)
+		meta["settings"]["optimizer"]["executionCounts"][signature] = Json::Value(Json::LargestUInt(count));
+
 	if (m_revertStrings != RevertStrings::Default)
 		meta["settings"]["debug"]["revertStrings"] = revertStringsToString(m_revertStrings);
 
@@ -162,6 +162,16 @@ public:
 		m_parserErrorRecovery = _wantErrorRecovery;
 	}
 
+	/// Set whether the bodies of functions and modifiers are only parsed once analysis starts.
+	/// Until then, they are empty blocks in the AST, which makes parsing and import resolution
+	/// faster for users that stop before analysis. Errors inside the bodies are reported by analyze().
+	/// Has no effect together with parser error recovery.
+	/// Must be set before parsing.
+	void setLazyFunctionBodies(bool _lazyFunctionBodies = false)
+	{
+		m_lazyFunctionBodies = _lazyFunctionBodies;
+	}
+
 	/// Sets the pipeline to go through the Yul IR or not.
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
@@ -205,6 +215,9 @@ public:
 
 	/// Sets the sources. Must be set before parsing.
 	void setSources(StringMap _sources);
+	/// Sets the sources, sharing the given buffers instead of copying them.
+	/// Must be set before parsing.
+	void setSources(SharedStringMap _sources);
 
 	/// Adds a response to an SMTLib2 query (identified by the hash of the query input).
 	/// Must be set before parsing.
@@ -301,7 +314,7 @@ public:
 	/// @return a verbose text representation of the assembly.
 	/// @arg _sourceCodes is the map of input files to source code strings
 	/// Prerequisite: Successful compilation.
-	std::string assemblyString(std::string const& _contractName, StringMap _sourceCodes = StringMap()) const;
+	std::string assemblyString(std::string const& _contractName, SharedStringMap const& _sourceCodes = SharedStringMap()) const;
 
 	/// @returns a JSON representation of the assembly.
 	/// @arg _sourceCodes is the map of input files to source code strings
@@ -381,6 +394,10 @@ private:
 	StringMap loadMissingSources(SourceUnit const& _ast, std::string const& _path);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
+	/// Parses the function bodies skipped because of lazy parsing and numbers
+	/// the AST nodes as if they had been parsed right away.
+	/// @returns false on error.
+	bool parseDeferredFunctionBodies();
 
 	/// Store the contract definitions in m_contracts.
 	void storeContractDefinitions();
@@ -489,6 +506,11 @@ private:
 	bool m_metadataLiteralSources = false;
 	MetadataHash m_metadataHash = MetadataHash::IPFS;
 	bool m_parserErrorRecovery = false;
+	bool m_lazyFunctionBodies = false;
+	/// Parser state of one source, see parse().
+	struct ParsedSource;
+	/// Parsers of the sources whose function bodies were skipped, in the order of parsing.
+	std::vector<std::shared_ptr<ParsedSource>> m_deferredSources;
 	State m_stackState = Empty;
 	bool m_importedSources = false;
 	/// Whether or not there has been an error during processing.
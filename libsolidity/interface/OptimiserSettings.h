@@ -24,6 +24,7 @@
 #pragma once
 
 #include <cstddef>
+#include <map>
 #include <string>
 
 namespace solidity::frontend
@@ -32,20 +33,21 @@ namespace solidity::frontend
 struct OptimiserSettings
 {
 	static char constexpr DefaultYulOptimiserSteps[] =
-		"NdhfoDgvulfnTUtnIf"            // None of these can make stack problems worse
+		"NdhfoDgvulfnTFUtnIf"           // None of these can make stack problems worse
 		"["
-			"xarrscLM"                 // Turn into SSA and simplify
-			"cCTUtTOntnfDIul"          // Perform structural simplification
-			"Lcul"                     // Simplify again
-			"Vcul jj"                  // Reverse SSA
+			"xarrscLM"                  // Turn into SSA and simplify
+			"cCTUtTOntnfDIul"           // Perform structural simplification
+			"Lcul"                      // Simplify again
+			"Vcul jj"                   // Reverse SSA
 
 			// should have good "compilability" property here.
 
-			"Tpeul"                    // Run functional expression inliner
-			"xarulrul"                 // Prune a bit more in SSA
-			"xarrcL"                   // Turn into SSA again and simplify
-			"gvif"                     // Run full inliner
-			"CTUcarrLsTOtfDncarrIulc"  // SSA plus simplify
+			"K"                         // Unroll loops with a small number of iterations
+			"Tpeul"                     // Run functional expression inliner
+			"xarulrul"                  // Prune a bit more in SSA
+			"xarrcL"                    // Turn into SSA again and simplify
+			"gvif"                      // Run full inliner
+			"CTUcarrALSsTOtfDncarrIulc" // SSA, keep small memory objects in variables and simplify
 		"]"
 		"jmuljuljul VcTOcul jmulN";     // Make source short and pretty
 
@@ -93,9 +95,11 @@ struct OptimiserSettings
 			runCSE == _other.runCSE &&
 			runConstantOptimiser == _other.runConstantOptimiser &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
+			optimizeStackLayout == _other.optimizeStackLayout &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
-			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
+			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment &&
+			functionExecutionCounts == _other.functionExecutionCounts;
 	}
 
 	/// Move literals to the right of commutative binary operators during code generation.
@@ -114,6 +118,9 @@ struct OptimiserSettings
 	bool runConstantOptimiser = false;
 	/// Perform more efficient stack allocation for variables during code generation from Yul to bytecode.
 	bool optimizeStackAllocation = false;
+	/// Choose stack layouts based on liveness information when generating bytecode from Yul,
+	/// instead of assigning fixed stack slots to variables.
+	bool optimizeStackLayout = false;
 	/// Yul optimiser with default settings. Will only run on certain parts of the code for now.
 	bool runYulOptimiser = false;
 	/// Sequence of optimisation steps to be performed by Yul optimiser.
@@ -124,6 +131,9 @@ struct OptimiserSettings
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Recorded numbers of executions of external functions, indexed by their signature.
+	/// Frequently called functions are dispatched first.
+	std::map<std::string, size_t> functionExecutionCounts;
 };
 
 }
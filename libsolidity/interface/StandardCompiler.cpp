@@ -428,7 +428,7 @@ std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _inp
 
 std::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 {
-	static set<string> keys{"details", "enabled", "runs"};
+	static set<string> keys{"details", "enabled", "executionCounts", "runs"};
 	return checkKeys(_input, keys, "settings.optimizer");
 }
 
@@ -560,6 +560,19 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 		settings.expectedExecutionsPerDeployment = _jsonInput["runs"].asUInt();
 	}
 
+	if (_jsonInput.isMember("executionCounts"))
+	{
+		Json::Value const& executionCounts = _jsonInput["executionCounts"];
+		if (!executionCounts.isObject())
+			return formatFatalError("JSONError", "\"settings.optimizer.executionCounts\" must be an object.");
+		for (auto const& signature: executionCounts.getMemberNames())
+		{
+			if (!executionCounts[signature].isUInt64())
+				return formatFatalError("JSONError", "Execution counts in \"settings.optimizer.executionCounts\" must be unsigned numbers.");
+			settings.functionExecutionCounts[signature] = executionCounts[signature].asUInt64();
+		}
+	}
+
 	if (_jsonInput.isMember("details"))
 	{
 		Json::Value const& details = _jsonInput["details"];
@@ -586,10 +599,12 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 			if (!settings.runYulOptimiser)
 				return formatFatalError("JSONError", "\"Providing yulDetails requires Yul optimizer to be enabled.");
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "stackLayout", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackLayout", settings.optimizeStackLayout))
+				return *error;
 			if (auto error = checkOptimizerDetailSteps(details["yulDetails"], "optimizerSteps", settings.yulOptimiserSteps))
 				return *error;
 		}
@@ -906,11 +921,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 	return { std::move(ret) };
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings, util::JsonStreamWriter* _writer)
 {
 	CompilerStack compilerStack(m_readFile);
 
-	StringMap sourceList = std::move(_inputsAndSettings.sources);
+	SharedStringMap sourceList;
+	for (auto& source: _inputsAndSettings.sources)
+		sourceList[source.first] = make_shared<string const>(std::move(source.second));
 	compilerStack.setSources(sourceList);
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
@@ -1085,20 +1102,40 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		{
 			Json::Value sourceResult = Json::objectValue;
 			sourceResult["id"] = sourceIndex++;
-			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
+			// When streaming, the AST is written at the end of this function.
+			if (!_writer && isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
 				sourceResult["ast"] = ASTJsonConverter(false, compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
 			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "legacyAST", wildcardMatchesExperimental))
 				sourceResult["legacyAST"] = ASTJsonConverter(true, compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
 			output["sources"][sourceName] = sourceResult;
 		}
 
-	Json::Value contractsOutput = Json::objectValue;
+	vector<pair<string, string>> fileAndContractNames;
 	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
 	{
 		size_t colon = contractName.rfind(':');
 		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
+		fileAndContractNames.emplace_back(contractName.substr(0, colon), contractName.substr(colon + 1));
+	}
+	// This is the order of the contracts in the output.
+	sort(fileAndContractNames.begin(), fileAndContractNames.end());
+
+	if (_writer)
+	{
+		_writer->beginObject();
+		if (output.isMember("auxiliaryInputRequested"))
+		{
+			_writer->key("auxiliaryInputRequested");
+			_writer->value(output["auxiliaryInputRequested"]);
+		}
+	}
+	// File whose contracts are currently being written to _writer.
+	optional<string> currentFile;
+
+	Json::Value contractsOutput = Json::objectValue;
+	for (auto const& [file, name]: fileAndContractNames)
+	{
+		string const contractName = file + ":" + name;
 
 		// ABI, storage layout, documentation and metadata
 		Json::Value contractData(Json::objectValue);
@@ -1167,17 +1204,73 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		if (!evmData.empty())
 			contractData["evm"] = evmData;
 
-		if (!contractData.empty())
+		if (contractData.empty())
+			continue;
+		if (_writer)
+		{
+			if (!currentFile)
+			{
+				_writer->key("contracts");
+				_writer->beginObject();
+			}
+			if (currentFile != file)
+			{
+				if (currentFile)
+					_writer->endObject();
+				_writer->key(file);
+				_writer->beginObject();
+				currentFile = file;
+			}
+			_writer->key(name);
+			_writer->value(contractData);
+		}
+		else
 		{
 			if (!contractsOutput.isMember(file))
 				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			contractsOutput[file][name] = std::move(contractData);
 		}
 	}
-	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
 
-	return output;
+	if (!_writer)
+	{
+		if (!contractsOutput.empty())
+			output["contracts"] = std::move(contractsOutput);
+		return output;
+	}
+
+	if (currentFile)
+	{
+		_writer->endObject();
+		_writer->endObject();
+	}
+	if (output.isMember("errors"))
+	{
+		_writer->key("errors");
+		_writer->value(output["errors"]);
+	}
+	_writer->key("sources");
+	_writer->beginObject();
+	for (string const& sourceName: output["sources"].getMemberNames())
+	{
+		Json::Value const& sourceResult = output["sources"][sourceName];
+		_writer->key(sourceName);
+		_writer->beginObject();
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
+		{
+			_writer->key("ast");
+			ASTJsonConverter(false, compilerStack.state(), compilerStack.sourceIndices()).print(*_writer, compilerStack.ast(sourceName));
+		}
+		for (string const& member: sourceResult.getMemberNames())
+		{
+			_writer->key(member);
+			_writer->value(sourceResult[member]);
+		}
+		_writer->endObject();
+	}
+	_writer->endObject();
+	_writer->endObject();
+	return Json::Value();
 }
 
 
@@ -1271,6 +1364,11 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
+{
+	return compile(_input, nullptr);
+}
+
+Json::Value StandardCompiler::compile(Json::Value const& _input, util::JsonStreamWriter* _writer) noexcept
 {
 	YulStringRepository::reset();
 
@@ -1281,7 +1379,7 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 			return std::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
 		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+			return compileSolidity(std::move(settings), _writer);
 		else if (settings.language == "Yul")
 			return compileYul(std::move(settings));
 		else
@@ -1319,13 +1417,15 @@ string StandardCompiler::compile(string const& _input) noexcept
 		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
 	}
 
-	// cout << "Input: " << input.toStyledString() << endl;
-	Json::Value output = compile(input);
-	// cout << "Output: " << output.toStyledString() << endl;
+	// Solidity output is written piece by piece, everything else is returned as Json::Value.
+	util::JsonStreamWriter writer(false);
+	Json::Value output = compile(input, &writer);
 
 	try
 	{
-		return util::jsonCompactPrint(output);
+		if (!output.isNull())
+			return util::jsonCompactPrint(output);
+		return std::move(writer.output());
 	}
 	catch (...)
 	{
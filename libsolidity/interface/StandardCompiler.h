@@ -29,6 +29,11 @@
 #include <utility>
 #include <variant>
 
+namespace solidity::util
+{
+class JsonStreamWriter;
+}
+
 namespace solidity::frontend
 {
 
@@ -79,7 +84,14 @@ private:
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Performs the processing steps of compile(). If @a _writer is given, Solidity output is
+	/// written to it piece by piece and a null value is returned. All other output, including
+	/// errors that prevent the output from being written, is returned.
+	Json::Value compile(Json::Value const& _input, util::JsonStreamWriter* _writer) noexcept;
+
+	/// Compiles Solidity sources. If @a _writer is given, the output is written to it contract by
+	/// contract instead of being returned, so that it never exists as a Json::Value as a whole.
+	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings, util::JsonStreamWriter* _writer = nullptr);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
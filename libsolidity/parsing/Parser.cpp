@@ -33,7 +33,9 @@
 #include <libyul/backends/evm/EVMDialect.h>
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/algorithm/string/replace.hpp>
+#include <algorithm>
 #include <cctype>
+#include <mutex>
 #include <vector>
 #include <regex>
 
@@ -65,7 +67,9 @@ public:
 		solAssert(m_location.source, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		auto node = make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		m_parser.m_createdNodes.emplace_back(node);
+		return node;
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -135,6 +139,61 @@ ASTPointer<SourceUnit> Parser::parse(shared_ptr<Scanner> const& _scanner)
 	}
 }
 
+bool Parser::parseDeferredFunctionBodies()
+{
+	// All nodes in the order in which they would have been created without deferring,
+	// i.e. with the nodes of each body right before the block standing in for it.
+	// The block created while parsing a body is discarded and does not count.
+	vector<weak_ptr<ASTNode>> nodes;
+	size_t const skimmedNodes = m_createdNodes.size();
+	size_t copiedNodes = 0;
+	try
+	{
+		for (DeferredBody const& body: m_deferredBodies)
+		{
+			size_t const firstBodyNode = m_createdNodes.size();
+			m_scanner->setPosition(static_cast<size_t>(body.block->location().start));
+			m_insideModifier = body.insideModifier;
+			m_recursionDepth = body.recursionDepth;
+			ASTPointer<Block> block = parseBlock();
+			m_insideModifier = false;
+			solAssert(m_recursionDepth == body.recursionDepth, "");
+			body.block->m_statements = std::move(block->m_statements);
+
+			nodes.insert(nodes.end(), m_createdNodes.begin() + static_cast<ptrdiff_t>(copiedNodes), m_createdNodes.begin() + static_cast<ptrdiff_t>(body.nodeIndex));
+			nodes.insert(nodes.end(), m_createdNodes.begin() + static_cast<ptrdiff_t>(firstBodyNode), m_createdNodes.end() - 1);
+			copiedNodes = body.nodeIndex;
+		}
+	}
+	catch (FatalError const&)
+	{
+		m_insideModifier = false;
+		m_recursionDepth = 0;
+		if (m_errorReporter.errors().empty())
+			throw; // Something is weird here, rather throw again.
+		return false;
+	}
+	nodes.insert(nodes.end(), m_createdNodes.begin() + static_cast<ptrdiff_t>(copiedNodes), m_createdNodes.begin() + static_cast<ptrdiff_t>(skimmedNodes));
+	m_deferredBodies.clear();
+
+	m_createdNodes = std::move(nodes);
+	m_currentNodeID = 0;
+	for (weak_ptr<ASTNode> const& node: m_createdNodes)
+	{
+		++m_currentNodeID;
+		if (shared_ptr<ASTNode> lockedNode = node.lock())
+			lockedNode->m_id = static_cast<size_t>(m_currentNodeID);
+	}
+	return true;
+}
+
+void Parser::shiftNodeIDs(int64_t _offset)
+{
+	for (weak_ptr<ASTNode> const& node: m_createdNodes)
+		if (shared_ptr<ASTNode> lockedNode = node.lock())
+			lockedNode->m_id = static_cast<size_t>(lockedNode->id() + _offset);
+}
+
 void Parser::parsePragmaVersion(SourceLocation const& _location, vector<Token> const& _tokens, vector<string> const& _literals)
 {
 	SemVerMatchExpressionParser parser(_tokens, _literals);
@@ -608,7 +667,7 @@ ASTPointer<ASTNode> Parser::parseFunctionDefinition(bool _freeFunction)
 		m_scanner->next();
 	else
 	{
-		block = parseBlock();
+		block = parseFunctionBody();
 		nodeFactory.setEndPositionFromNode(block);
 	}
 	return nodeFactory.createNode<FunctionDefinition>(
@@ -861,7 +920,7 @@ ASTPointer<ModifierDefinition> Parser::parseModifierDefinition()
 	nodeFactory.markEndPosition();
 	if (m_scanner->currentToken() != Token::Semicolon)
 	{
-		block = parseBlock();
+		block = parseFunctionBody();
 		nodeFactory.setEndPositionFromNode(block);
 	}
 	else
@@ -1117,6 +1176,38 @@ ASTPointer<Block> Parser::parseBlock(ASTPointer<ASTString> const& _docString)
 	return nodeFactory.createNode<Block>(_docString, statements);
 }
 
+ASTPointer<Block> Parser::parseFunctionBody()
+{
+	if (!m_deferFunctionBodies || m_scanner->currentToken() != Token::LBrace)
+		return parseBlock();
+
+	// Only find the matching closing brace, the body itself is parsed
+	// by parseDeferredFunctionBodies().
+	ASTNodeFactory nodeFactory(*this);
+	size_t const start = static_cast<size_t>(m_scanner->currentLocation().start);
+	size_t depth = 0;
+	do
+	{
+		if (m_scanner->currentToken() == Token::LBrace)
+			depth++;
+		else if (m_scanner->currentToken() == Token::RBrace)
+			depth--;
+		else if (m_scanner->currentToken() == Token::EOS)
+		{
+			// The body is not terminated, parse it right away to report the error.
+			m_scanner->setPosition(start);
+			return parseBlock();
+		}
+		nodeFactory.markEndPosition();
+		m_scanner->next();
+	}
+	while (depth > 0);
+
+	ASTPointer<Block> block = nodeFactory.createNode<Block>(nullptr, vector<ASTPointer<Statement>>{});
+	m_deferredBodies.push_back({block, m_createdNodes.size() - 1, m_insideModifier, m_recursionDepth});
+	return block;
+}
+
 ASTPointer<Statement> Parser::parseStatement()
 {
 	RecursionGuard recursionGuard(*this);
@@ -1209,6 +1300,12 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 	SourceLocation location = currentLocation();
 
 	expectToken(Token::Assembly);
+
+	// Dialect creation and the YulStrings created by the Yul parser use global state,
+	// so only one parser at a time can do this if several source units are parsed in parallel.
+	static mutex yulParserMutex;
+	lock_guard<mutex> yulParserLock(yulParserMutex);
+
 	yul::Dialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
 	if (m_scanner->currentToken() == Token::StringLiteral)
 	{
@@ -1224,7 +1321,9 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 		BOOST_THROW_EXCEPTION(FatalError());
 
 	location.end = block->location.end;
-	return make_shared<InlineAssembly>(nextID(), location, _docString, dialect, block);
+	auto inlineAssembly = make_shared<InlineAssembly>(nextID(), location, _docString, dialect, block);
+	m_createdNodes.emplace_back(inlineAssembly);
+	return inlineAssembly;
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
@@ -1946,7 +2045,8 @@ bool Parser::variableDeclarationStart()
 optional<string> Parser::findLicenseString(std::vector<ASTPointer<ASTNode>> const& _nodes)
 {
 	// We circumvent the scanner here, because it skips non-docstring comments.
-	static regex const licenseRegex("SPDX-License-Identifier:\\s*([a-zA-Z0-9 ()+.-]+)");
+	static string const licensePrefix("SPDX-License-Identifier:");
+	static regex const licenseRegex(licensePrefix + "\\s*([a-zA-Z0-9 ()+.-]+)");
 
 	// Search inside all parts of the source not covered by parsed nodes.
 	// This will leave e.g. "global comments".
@@ -1964,13 +2064,21 @@ optional<string> Parser::findLicenseString(std::vector<ASTPointer<ASTNode>> cons
 	vector<string> matches;
 	for (auto const& [start, end]: sequencesToSearch)
 	{
+		// Only try the regular expression where the prefix occurs, since
+		// searching the whole source with it is slow for large comments.
 		smatch match;
-		if (regex_search(start, end, match, licenseRegex))
-		{
-			string license{boost::trim_copy(string(match[1]))};
-			if (!license.empty())
-				matches.emplace_back(std::move(license));
-		}
+		for (
+			auto position = search(start, end, licensePrefix.begin(), licensePrefix.end());
+			position != end;
+			position = search(position + 1, end, licensePrefix.begin(), licensePrefix.end())
+		)
+			if (regex_search(position, end, match, licenseRegex, regex_constants::match_continuous))
+			{
+				string license{boost::trim_copy(string(match[1]))};
+				if (!license.empty())
+					matches.emplace_back(std::move(license));
+				break;
+			}
 	}
 
 	if (matches.size() == 1)
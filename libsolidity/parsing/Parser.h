@@ -38,17 +38,36 @@ namespace solidity::frontend
 class Parser: public langutil::ParserBase
 {
 public:
+	/// @param _deferFunctionBodies if true, the bodies of functions and modifiers are only
+	/// skipped over and replaced by empty blocks until parseDeferredFunctionBodies() is called.
+	/// Not supported together with error recovery.
 	explicit Parser(
 		langutil::ErrorReporter& _errorReporter,
 		langutil::EVMVersion _evmVersion,
-		bool _errorRecovery = false
+		bool _errorRecovery = false,
+		bool _deferFunctionBodies = false
 	):
 		ParserBase(_errorReporter, _errorRecovery),
-		m_evmVersion(_evmVersion)
+		m_evmVersion(_evmVersion),
+		m_deferFunctionBodies(_deferFunctionBodies && !_errorRecovery)
 	{}
 
 	ASTPointer<SourceUnit> parse(std::shared_ptr<langutil::Scanner> const& _scanner);
 
+	/// Parses the function and modifier bodies skipped by parse() into their blocks and
+	/// renumbers all nodes of this parser to the IDs they would have received if the bodies
+	/// had been parsed right away. Errors inside the bodies are only reported here.
+	/// IDs shifted by shiftNodeIDs() before are reset, so they have to be shifted again.
+	/// @returns false if a fatal error occurred.
+	bool parseDeferredFunctionBodies();
+
+	/// @returns the number of node IDs handed out by this parser so far.
+	int64_t nodeCount() const { return m_currentNodeID; }
+	/// Adds @a _offset to the IDs of all nodes created by this parser.
+	/// Used to number the nodes of source units that were parsed by separate parsers
+	/// exactly as if a single parser had parsed them one after the other.
+	void shiftNodeIDs(int64_t _offset);
+
 private:
 	class ASTNodeFactory;
 
@@ -115,6 +134,9 @@ private:
 		bool _allowEmpty = true
 	);
 	ASTPointer<Block> parseBlock(ASTPointer<ASTString> const& _docString = {});
+	/// Parses the body of a function or modifier, or skips over it and returns an empty
+	/// block if function bodies are deferred.
+	ASTPointer<Block> parseFunctionBody();
 	ASTPointer<Statement> parseStatement();
 	ASTPointer<InlineAssembly> parseInlineAssembly(ASTPointer<ASTString> const& _docString = {});
 	ASTPointer<IfStatement> parseIfStatement(ASTPointer<ASTString> const& _docString);
@@ -210,6 +232,21 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	/// All nodes created so far, including ones that were discarded again.
+	std::vector<std::weak_ptr<ASTNode>> m_createdNodes;
+
+	/// A function or modifier body that was skipped by parse().
+	struct DeferredBody
+	{
+		/// The empty block standing in for the body.
+		ASTPointer<Block> block;
+		/// Position of the block in m_createdNodes.
+		size_t nodeIndex;
+		bool insideModifier;
+		size_t recursionDepth;
+	};
+	bool m_deferFunctionBodies = false;
+	std::vector<DeferredBody> m_deferredBodies;
 };
 
 }
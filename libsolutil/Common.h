@@ -48,6 +48,7 @@
 #include <boost/multiprecision/cpp_int.hpp>
 
 #include <map>
+#include <memory>
 #include <utility>
 #include <vector>
 #include <functional>
@@ -69,6 +70,7 @@ using u160 = boost::multiprecision::number<boost::multiprecision::cpp_int_backen
 
 // Map types.
 using StringMap = std::map<std::string, std::string>;
+using SharedStringMap = std::map<std::string, std::shared_ptr<std::string const>>;
 
 // String types.
 using strings = std::vector<std::string>;
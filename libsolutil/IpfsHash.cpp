@@ -46,9 +46,29 @@ bytes encodeByteArray(bytes const& _data)
 	return bytes{0x0a} + varintEncoding(_data.size()) + _data;
 }
 
+/// Computes the multihash (sha2-256) of the concatenation of @a _parts.
+/// The parts are fed to the hasher in small pieces, so that they never have to be
+/// copied into one contiguous buffer (neither here nor inside the hasher).
+bytes encodeHash(vector<bytesConstRef> const& _parts)
+{
+	size_t const pieceSize = 0x1000;
+	picosha2::hash256_one_by_one hasher;
+	for (bytesConstRef part: _parts)
+		for (size_t offset = 0; offset < part.size(); offset += pieceSize)
+		{
+			bytesConstRef piece = part.cropped(offset, min(pieceSize, part.size() - offset));
+			hasher.process(piece.begin(), piece.end());
+		}
+	hasher.finish();
+
+	bytes hash(picosha2::k_digest_size);
+	hasher.get_hash_bytes(hash.begin(), hash.end());
+	return bytes{0x12, 0x20} + hash;
+}
+
 bytes encodeHash(bytes const& _data)
 {
-	return bytes{0x12, 0x20} + picosha2::hash256(_data);
+	return encodeHash(vector<bytesConstRef>{&_data});
 }
 
 bytes encodeLinkData(bytes const& _data)
@@ -153,7 +173,7 @@ bytes groupChunksBottomUp(Chunks _currentLevel)
 }
 }
 
-bytes solidity::util::ipfsHash(string _data)
+bytes solidity::util::ipfsHash(string_view _data)
 {
 	size_t const maxChunkSize = 1024 * 256;
 	size_t chunkCount = _data.length() / maxChunkSize + (_data.length() % maxChunkSize > 0 ? 1 : 0);
@@ -163,41 +183,44 @@ bytes solidity::util::ipfsHash(string _data)
 
 	for (size_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
 	{
-		bytes chunkBytes = asBytes(
-			_data.substr(chunkIndex * maxChunkSize, min(maxChunkSize, _data.length() - chunkIndex * maxChunkSize))
+		size_t const offset = chunkIndex * maxChunkSize;
+		bytesConstRef chunkBytes(
+			reinterpret_cast<uint8_t const*>(_data.data()) + offset,
+			min(maxChunkSize, _data.length() - offset)
 		);
 
 		bytes lengthAsVarint = varintEncoding(chunkBytes.size());
 
-		bytes protobufEncodedData;
+		// The protobuf encoding is only built around the chunk data, which is hashed in place.
+		bytes protobufHeader;
 		// Type: File
-		protobufEncodedData += bytes{0x08, 0x02};
+		protobufHeader += bytes{0x08, 0x02};
 		if (!chunkBytes.empty())
 		{
 			// Data (length delimited bytes)
-			protobufEncodedData += bytes{0x12};
-			protobufEncodedData += lengthAsVarint;
-			protobufEncodedData += chunkBytes;
+			protobufHeader += bytes{0x12};
+			protobufHeader += lengthAsVarint;
 		}
 		// filesize: length as varint
-		protobufEncodedData += bytes{0x18} + lengthAsVarint;
+		bytes protobufFooter = bytes{0x18} + lengthAsVarint;
+		size_t protobufSize = protobufHeader.size() + chunkBytes.size() + protobufFooter.size();
 
 		// PBDag:
 		// Data: (length delimited bytes)
-		bytes blockData = encodeByteArray(protobufEncodedData);
+		bytes blockHeader = bytes{0x0a} + varintEncoding(protobufSize) + protobufHeader;
 
 		// Multihash: sha2-256, 256 bits
 		allChunks.emplace_back(
-			encodeHash(blockData),
+			encodeHash({&blockHeader, chunkBytes, &protobufFooter}),
 			chunkBytes.size(),
-			blockData.size()
+			blockHeader.size() + chunkBytes.size() + protobufFooter.size()
 		);
 	}
 
 	return groupChunksBottomUp(std::move(allChunks));
 }
 
-string solidity::util::ipfsHashBase58(string _data)
+string solidity::util::ipfsHashBase58(string_view _data)
 {
-	return base58Encode(ipfsHash(std::move(_data)));
+	return base58Encode(ipfsHash(_data));
 }
@@ -22,6 +22,7 @@
 
 #include <libsolutil/JSON.h>
 
+#include <libsolutil/Assertions.h>
 #include <libsolutil/CommonIO.h>
 
 #include <boost/algorithm/string/replace.hpp>
@@ -105,6 +106,15 @@ void removeNullMembersHelper(Json::Value& _json)
 		}
 }
 
+/// @returns @a _value as a quoted and escaped JSON string, in the same way as the stream writers do.
+string quotedString(string const& _value)
+{
+	// valueToQuotedString stops at the first null character.
+	if (_value.find('\0') != string::npos)
+		return jsonCompactPrint(Json::Value(_value));
+	return Json::valueToQuotedString(_value.c_str());
+}
+
 } // end anonymous namespace
 
 Json::Value removeNullMembers(Json::Value _json)
@@ -135,4 +145,154 @@ bool jsonParseStrict(string const& _input, Json::Value& _json, string* _errs /*
 	return parse(readerBuilder, _input, _json, _errs);
 }
 
+void JsonStreamWriter::key(string const& _key)
+{
+	assertThrow(!m_containers.empty() && !m_containers.back().isArray && !m_afterKey, Exception, "Unexpected JSON key.");
+	Container& container = m_containers.back();
+	open(container);
+	if (!container.empty)
+		m_output += ',';
+	container.empty = false;
+	newline();
+	m_output += quotedString(_key);
+	m_output += ':';
+	m_afterKey = true;
+}
+
+void JsonStreamWriter::value(Json::Value const& _value)
+{
+	switch (_value.type())
+	{
+	case Json::objectValue:
+		beginObject();
+		for (auto const& name: _value.getMemberNames())
+		{
+			key(name);
+			value(_value[name]);
+		}
+		endObject();
+		return;
+	case Json::arrayValue:
+		beginArray();
+		for (auto const& element: _value)
+			value(element);
+		endArray();
+		return;
+	default:
+		break;
+	}
+
+	beginValue();
+	if (m_afterKey && m_pretty)
+		m_output += ' ';
+	m_afterKey = false;
+	switch (_value.type())
+	{
+	case Json::nullValue:
+		m_output += "null";
+		break;
+	case Json::intValue:
+		m_output += Json::valueToString(_value.asLargestInt());
+		break;
+	case Json::uintValue:
+		m_output += Json::valueToString(_value.asLargestUInt());
+		break;
+	case Json::realValue:
+		m_output += Json::valueToString(_value.asDouble());
+		break;
+	case Json::stringValue:
+		m_output += quotedString(_value.asString());
+		break;
+	case Json::booleanValue:
+		m_output += Json::valueToString(_value.asBool());
+		break;
+	default:
+		assertThrow(false, Exception, "");
+	}
+	flushIfLarge();
+}
+
+void JsonStreamWriter::flush()
+{
+	if (m_stream)
+	{
+		*m_stream << m_output;
+		m_output.clear();
+	}
+}
+
+void JsonStreamWriter::beginContainer(bool _isArray)
+{
+	beginValue();
+	m_containers.push_back({_isArray, m_afterKey});
+	m_afterKey = false;
+}
+
+void JsonStreamWriter::endContainer(bool _isArray)
+{
+	assertThrow(!m_containers.empty() && m_containers.back().isArray == _isArray && !m_afterKey, Exception, "Unexpected end of JSON container.");
+	Container container = m_containers.back();
+	m_containers.pop_back();
+	if (container.pending)
+	{
+		// Empty containers are written like scalars.
+		if (container.isMemberValue && m_pretty)
+			m_output += ' ';
+		m_output += _isArray ? "[]" : "{}";
+	}
+	else
+	{
+		newline();
+		m_output += _isArray ? ']' : '}';
+	}
+	flushIfLarge();
+}
+
+void JsonStreamWriter::beginValue()
+{
+	if (m_containers.empty())
+		return;
+	Container& container = m_containers.back();
+	if (container.isArray)
+	{
+		open(container);
+		if (!container.empty)
+			m_output += ',';
+		container.empty = false;
+		newline();
+	}
+	else
+		assertThrow(m_afterKey, Exception, "JSON object member without key.");
+}
+
+void JsonStreamWriter::open(Container& _container)
+{
+	if (!_container.pending)
+		return;
+	// Non-empty objects and arrays that are member values start on a new line,
+	// at the indentation level of the key.
+	if (_container.isMemberValue && m_pretty)
+	{
+		m_output += '\n';
+		m_output.append(2 * (m_containers.size() - 1), ' ');
+	}
+	m_output += _container.isArray ? '[' : '{';
+	_container.pending = false;
+}
+
+void JsonStreamWriter::newline()
+{
+	if (m_pretty)
+	{
+		m_output += '\n';
+		m_output.append(2 * m_containers.size(), ' ');
+	}
+}
+
+void JsonStreamWriter::flushIfLarge()
+{
+	if (m_output.size() >= 0x10000)
+		flush();
+}
+
 } // namespace solidity::util
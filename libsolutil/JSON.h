@@ -25,7 +25,9 @@
 
 #include <json/json.h>
 
+#include <ostream>
 #include <string>
+#include <vector>
 
 namespace solidity::util {
 
@@ -45,4 +47,57 @@ std::string jsonCompactPrint(Json::Value const& _input);
 /// \return \c true if the document was successfully parsed, \c false if an error occurred.
 bool jsonParseStrict(std::string const& _input, Json::Value& _json, std::string* _errs = nullptr);
 
+/**
+ * Serialises JSON piece by piece, without the need to build the complete Json::Value first.
+ * The output is identical to that of jsonPrettyPrint or jsonCompactPrint applied to the
+ * complete value, provided the members of each object are written in sorted key order.
+ */
+class JsonStreamWriter
+{
+public:
+	/// Creates a writer that keeps the output in memory, see output().
+	explicit JsonStreamWriter(bool _pretty): m_pretty(_pretty) {}
+	/// Creates a writer that passes the output on to @a _stream in chunks.
+	JsonStreamWriter(std::ostream& _stream, bool _pretty): m_stream(&_stream), m_pretty(_pretty) {}
+	~JsonStreamWriter() { flush(); }
+
+	void beginObject() { beginContainer(false); }
+	void endObject() { endContainer(false); }
+	void beginArray() { beginContainer(true); }
+	void endArray() { endContainer(true); }
+	/// Writes the key of the next member of the current object.
+	void key(std::string const& _key);
+	/// Writes a complete value, which can also be an object or an array.
+	void value(Json::Value const& _value);
+
+	/// Passes all pending output on to the stream, if there is one.
+	void flush();
+	/// @returns the output that was not yet passed on to a stream.
+	std::string& output() { return m_output; }
+
+private:
+	struct Container
+	{
+		bool isArray = false;
+		bool isMemberValue = false;
+		/// True as long as the opening bracket has not been written.
+		bool pending = true;
+		bool empty = true;
+	};
+
+	void beginContainer(bool _isArray);
+	void endContainer(bool _isArray);
+	/// Writes everything that has to precede the next value in the current container.
+	void beginValue();
+	void open(Container& _container);
+	void newline();
+	void flushIfLarge();
+
+	std::ostream* m_stream = nullptr;
+	bool m_pretty = false;
+	bool m_afterKey = false;
+	std::vector<Container> m_containers;
+	std::string m_output;
+};
+
 }
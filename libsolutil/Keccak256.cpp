@@ -22,10 +22,18 @@
 
 #include <libsolutil/Keccak256.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <numeric>
+
+// The batched hash function processes several messages in parallel using the 256-bit vector
+// registers of AVX2, if the CPU we are running on supports it.
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__) && !defined(__EMSCRIPTEN__)
+#define SOL_KECCAK_AVX2 1
+#endif
 
 using namespace std;
 
@@ -171,6 +179,125 @@ inline void hash(
 	memset(a, 0, 200);
 }
 
+#ifdef SOL_KECCAK_AVX2
+
+/******** Multi-buffer hashing. ********/
+
+/// Number of messages that are hashed together.
+size_t constexpr c_lanes = 4;
+/// The Keccak-256 rate in bytes, i.e. the size of one input block.
+size_t constexpr c_rate = 200 - (256 / 4);
+
+/// Keccak state of c_lanes messages, stored interleaved, i.e. word by word.
+using LaneState = uint64_t[25][c_lanes];
+
+/// @returns the number of permutations needed to hash @a _input, including the padding block.
+size_t blockCount(bytesConstRef _input)
+{
+	return _input.size() / c_rate + 1;
+}
+
+/// Xors block number @a _block of @a _input (padded if it is the last one) into lane @a _lane.
+void absorbBlock(LaneState& _state, size_t _lane, bytesConstRef _input, size_t _block)
+{
+	uint8_t buffer[c_rate] = {0};
+	size_t offset = _block * c_rate;
+	size_t length = min(c_rate, _input.size() - offset);
+	if (length > 0)
+		memcpy(buffer, _input.data() + offset, length);
+	if (_block + 1 == blockCount(_input))
+	{
+		buffer[length] ^= 0x01;
+		buffer[c_rate - 1] ^= 0x80;
+	}
+	for (size_t i = 0; i < c_rate / 8; ++i)
+	{
+		uint64_t word;
+		memcpy(&word, buffer + 8 * i, 8);
+		_state[i][_lane] ^= word;
+	}
+}
+
+using Lanes = uint64_t __attribute__((vector_size(8 * c_lanes)));
+
+/// Keccak-f[1600] applied to all lanes at once. All helpers are macros, since functions
+/// without the AVX2 target attribute would not be inlined into this function.
+__attribute__((target("avx2"))) void keccakfLanes(LaneState& _state)
+{
+#define rolLanes(x, s) (((x) << (s)) | ((x) >> (64 - (s))))
+#define THETA_C(x) b[x] = a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^ a[x + 20];
+#define THETA_D(x) \
+	t = b[(x + 4) % 5] ^ rolLanes(b[(x + 1) % 5], 1); \
+	a[x] ^= t; a[x + 5] ^= t; a[x + 10] ^= t; a[x + 15] ^= t; a[x + 20] ^= t;
+#define RHO_PI(x) \
+	u = a[pi[x]]; \
+	a[pi[x]] = rolLanes(t, rho[x]); \
+	t = u;
+#define CHI(y) \
+	b[0] = a[y]; b[1] = a[y + 1]; b[2] = a[y + 2]; b[3] = a[y + 3]; b[4] = a[y + 4]; \
+	a[y] = b[0] ^ (~b[1] & b[2]); \
+	a[y + 1] = b[1] ^ (~b[2] & b[3]); \
+	a[y + 2] = b[2] ^ (~b[3] & b[4]); \
+	a[y + 3] = b[3] ^ (~b[4] & b[0]); \
+	a[y + 4] = b[4] ^ (~b[0] & b[1]);
+
+	Lanes a[25];
+	Lanes b[5];
+	Lanes t;
+	Lanes u;
+	memcpy(a, _state, sizeof(a));
+	for (int i = 0; i < 24; i++)
+	{
+		// Theta
+		THETA_C(0) THETA_C(1) THETA_C(2) THETA_C(3) THETA_C(4)
+		THETA_D(0) THETA_D(1) THETA_D(2) THETA_D(3) THETA_D(4)
+		// Rho and pi
+		t = a[1];
+		RHO_PI(0) RHO_PI(1) RHO_PI(2) RHO_PI(3) RHO_PI(4) RHO_PI(5)
+		RHO_PI(6) RHO_PI(7) RHO_PI(8) RHO_PI(9) RHO_PI(10) RHO_PI(11)
+		RHO_PI(12) RHO_PI(13) RHO_PI(14) RHO_PI(15) RHO_PI(16) RHO_PI(17)
+		RHO_PI(18) RHO_PI(19) RHO_PI(20) RHO_PI(21) RHO_PI(22) RHO_PI(23)
+		// Chi
+		CHI(0) CHI(5) CHI(10) CHI(15) CHI(20)
+		// Iota
+		a[0] ^= RC[i];
+	}
+	memcpy(_state, a, sizeof(a));
+
+#undef rolLanes
+#undef THETA_C
+#undef THETA_D
+#undef RHO_PI
+#undef CHI
+}
+
+bool haveAVX2()
+{
+	static bool const result = []() {
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") != 0;
+	}();
+	return result;
+}
+
+/// Hashes the c_lanes inputs referenced by @a _indices, which all have the same block count.
+void hashLanes(vector<bytesConstRef> const& _inputs, size_t const* _indices, vector<h256>& _hashes)
+{
+	LaneState state = {};
+	size_t const blocks = blockCount(_inputs[_indices[0]]);
+	for (size_t block = 0; block < blocks; ++block)
+	{
+		for (size_t lane = 0; lane < c_lanes; ++lane)
+			absorbBlock(state, lane, _inputs[_indices[lane]], block);
+		keccakfLanes(state);
+	}
+	for (size_t lane = 0; lane < c_lanes; ++lane)
+		for (size_t i = 0; i < h256::size / 8; ++i)
+			memcpy(_hashes[_indices[lane]].data() + 8 * i, &state[i][lane], 8);
+}
+
+#endif
+
 }
 
 h256 keccak256(bytesConstRef _input)
@@ -184,4 +311,40 @@ h256 keccak256(bytesConstRef _input)
 	return output;
 }
 
+vector<h256> keccak256Batch(vector<bytesConstRef> const& _inputs)
+{
+	vector<h256> hashes(_inputs.size());
+
+#ifdef SOL_KECCAK_AVX2
+	if (haveAVX2())
+	{
+		// Sort by block count, so that the messages hashed together need the same number of permutations.
+		vector<size_t> order(_inputs.size());
+		iota(order.begin(), order.end(), 0);
+		stable_sort(order.begin(), order.end(), [&](size_t _a, size_t _b) {
+			return blockCount(_inputs[_a]) < blockCount(_inputs[_b]);
+		});
+		size_t i = 0;
+		while (i + c_lanes <= order.size())
+			if (blockCount(_inputs[order[i]]) == blockCount(_inputs[order[i + c_lanes - 1]]))
+			{
+				hashLanes(_inputs, &order[i], hashes);
+				i += c_lanes;
+			}
+			else
+			{
+				hashes[order[i]] = keccak256(_inputs[order[i]]);
+				++i;
+			}
+		for (; i < order.size(); ++i)
+			hashes[order[i]] = keccak256(_inputs[order[i]]);
+		return hashes;
+	}
+#endif
+
+	for (size_t i = 0; i < _inputs.size(); ++i)
+		hashes[i] = keccak256(_inputs[i]);
+	return hashes;
+}
+
 }
@@ -0,0 +1,87 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Helpers to process independent work items on several threads.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace solidity::util
+{
+
+/// @returns the number of threads parallelFor uses by default, which is one
+/// if the platform does not support threads.
+inline size_t defaultThreadCount()
+{
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+	return 1;
+#else
+	return std::max(1u, std::thread::hardware_concurrency());
+#endif
+}
+
+/// Calls @a _function for every index in [0, _count), distributing the calls over
+/// up to @a _threads threads (including the calling one). The calls have to be independent
+/// of each other and must not touch shared state without synchronisation.
+/// All calls are made even if some of them throw. Afterwards, the exception of the call
+/// with the lowest index is rethrown, so that the result does not depend on scheduling.
+template <typename F>
+void parallelFor(size_t _count, F const& _function, size_t _threads = defaultThreadCount())
+{
+	size_t const threadCount = std::min(_count, _threads);
+	if (threadCount <= 1)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_function(i);
+		return;
+	}
+
+	std::atomic<size_t> nextIndex{0};
+	std::vector<std::exception_ptr> exceptions(_count);
+	auto work = [&]() {
+		for (size_t i = nextIndex++; i < _count; i = nextIndex++)
+			try
+			{
+				_function(i);
+			}
+			catch (...)
+			{
+				exceptions[i] = std::current_exception();
+			}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < threadCount; ++i)
+		threads.emplace_back(work);
+	work();
+	for (std::thread& thread: threads)
+		thread.join();
+
+	for (std::exception_ptr const& exception: exceptions)
+		if (exception)
+			std::rethrow_exception(exception);
+}
+
+}
@@ -20,6 +20,7 @@
 
 #include <libsolutil/SwarmHash.h>
 
+#include <libsolutil/Assertions.h>
 #include <libsolutil/Keccak256.h>
 
 using namespace std;
@@ -65,14 +66,26 @@ h256 swarmHashIntermediate(string const& _input, size_t _offset, size_t _length)
 
 h256 bmtHash(bytesConstRef _data)
 {
-	if (_data.size() <= 64)
-		return keccak256(_data);
-
-	size_t midPoint = _data.size() / 2;
-	return keccak256(
-		bmtHash(_data.cropped(0, midPoint)).asBytes() +
-		bmtHash(_data.cropped(midPoint)).asBytes()
-	);
+	assertThrow(_data.size() == 0x1000, Exception, "Binary Merkle tree hash requires a full chunk.");
+
+	// A full chunk forms a perfect binary tree with 64-byte leaves. Hash it level by level,
+	// so that all nodes of one level can be hashed together.
+	vector<bytesConstRef> nodes;
+	for (size_t i = 0; i < _data.size(); i += 64)
+		nodes.emplace_back(_data.cropped(i, 64));
+	vector<h256> hashes = keccak256Batch(nodes);
+	bytes level;
+	while (hashes.size() > 1)
+	{
+		level.clear();
+		for (h256 const& hash: hashes)
+			level += hash.asBytes();
+		nodes.clear();
+		for (size_t i = 0; i < level.size(); i += 64)
+			nodes.emplace_back(bytesConstRef(&level).cropped(i, 64));
+		hashes = keccak256Batch(nodes);
+	}
+	return hashes.front();
 }
 
 h256 chunkHash(bytesConstRef const _data, bool _forceHigherLevel = false)
@@ -110,9 +123,9 @@ h256 solidity::util::bzzr0Hash(string const& _input)
 }
 
 
-h256 solidity::util::bzzr1Hash(bytes const& _input)
+h256 solidity::util::bzzr1Hash(bytesConstRef _input)
 {
 	if (_input.empty())
 		return h256{};
-	return chunkHash(&_input);
+	return chunkHash(_input);
 }
@@ -165,7 +165,19 @@ void AssemblyStack::compileEVM(AbstractAssembly& _assembly, bool _evm15, bool _o
 			break;
 	}
 
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _evm15, _optimize);
+	// Only optimise the selection of switch cases for gas if the optimiser is enabled.
+	optional<size_t> expectedExecutionsPerDeployment;
+	if (_optimize)
+		expectedExecutionsPerDeployment = m_optimiserSettings.expectedExecutionsPerDeployment;
+	EVMObjectCompiler::compile(
+		*m_parserResult,
+		_assembly,
+		*dialect,
+		_evm15,
+		_optimize,
+		expectedExecutionsPerDeployment,
+		m_optimiserSettings.optimizeStackLayout
+	);
 }
 
 void AssemblyStack::optimize(Object& _object, bool _isCreation)
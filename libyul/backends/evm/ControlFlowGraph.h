@@ -0,0 +1,203 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Control flow graph of a Yul block whose operations are expressed in terms of the
+ * stack slots they consume and produce. Used by the stack layout aware code generator.
+ */
+
+#pragma once
+
+#include <libyul/AsmDataForward.h>
+#include <libyul/AsmScope.h>
+
+#include <libsolutil/Common.h>
+
+#include <liblangutil/SourceLocation.h>
+
+#include <list>
+#include <map>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct BuiltinFunctionForEVM;
+
+/// The label pushed as return address for the call @a call to a user-defined function.
+struct FunctionCallReturnLabelSlot
+{
+	FunctionCall const* call = nullptr;
+	bool operator==(FunctionCallReturnLabelSlot const& _rhs) const { return call == _rhs.call; }
+	bool operator<(FunctionCallReturnLabelSlot const& _rhs) const { return call < _rhs.call; }
+};
+/// The return address of the function currently being generated.
+struct FunctionReturnLabelSlot
+{
+	bool operator==(FunctionReturnLabelSlot const&) const { return true; }
+	bool operator<(FunctionReturnLabelSlot const&) const { return false; }
+};
+/// The current value of a variable.
+struct VariableSlot
+{
+	Scope::Variable const* variable = nullptr;
+	bool operator==(VariableSlot const& _rhs) const { return variable == _rhs.variable; }
+	bool operator<(VariableSlot const& _rhs) const { return variable < _rhs.variable; }
+};
+/// A constant, which can be pushed whenever it is needed.
+struct LiteralSlot
+{
+	u256 value;
+	bool operator==(LiteralSlot const& _rhs) const { return value == _rhs.value; }
+	bool operator<(LiteralSlot const& _rhs) const { return value < _rhs.value; }
+};
+/// The @a index-th return value of the function call @a call.
+struct TemporarySlot
+{
+	FunctionCall const* call = nullptr;
+	size_t index = 0;
+	bool operator==(TemporarySlot const& _rhs) const { return call == _rhs.call && index == _rhs.index; }
+	bool operator<(TemporarySlot const& _rhs) const
+	{
+		return std::make_tuple(call, index) < std::make_tuple(_rhs.call, _rhs.index);
+	}
+};
+/// A copy of the @a index-th argument of @a call, pushed before the arguments
+/// to its right are evaluated, so that it ends up below their values.
+struct ArgumentSlot
+{
+	FunctionCall const* call = nullptr;
+	size_t index = 0;
+	bool operator==(ArgumentSlot const& _rhs) const { return call == _rhs.call && index == _rhs.index; }
+	bool operator<(ArgumentSlot const& _rhs) const
+	{
+		return std::make_tuple(call, index) < std::make_tuple(_rhs.call, _rhs.index);
+	}
+};
+/// A slot whose value is not needed anymore.
+struct JunkSlot
+{
+	bool operator==(JunkSlot const&) const { return true; }
+	bool operator<(JunkSlot const&) const { return false; }
+};
+
+using StackSlot = std::variant<
+	FunctionCallReturnLabelSlot,
+	FunctionReturnLabelSlot,
+	VariableSlot,
+	LiteralSlot,
+	TemporarySlot,
+	ArgumentSlot,
+	JunkSlot
+>;
+/// Stack layout, the last element is the top of the stack.
+using Stack = std::vector<StackSlot>;
+
+/**
+ * Control flow graph of the top-level code and all functions of a Yul block.
+ * Each basic block consists of a sequence of operations, each of which consumes
+ * its input slots from the top of the stack and replaces them by its output slots.
+ */
+struct CFG
+{
+	struct BuiltinCall
+	{
+		FunctionCall const* call = nullptr;
+		BuiltinFunctionForEVM const* builtin = nullptr;
+	};
+	struct UserFunctionCall
+	{
+		FunctionCall const* call = nullptr;
+		Scope::Function const* function = nullptr;
+	};
+	/// Does not generate code but gives new names to the input slots.
+	struct Assignment
+	{
+		/// The variables assigned to, empty if the operation pushes function call
+		/// arguments or return labels early.
+		std::vector<VariableSlot> variables;
+	};
+
+	struct Operation
+	{
+		/// Slots consumed by the operation, the last one has to be on top of the stack.
+		Stack input;
+		/// Slots produced by the operation in place of the input.
+		Stack output;
+		std::variant<BuiltinCall, UserFunctionCall, Assignment> operation;
+		langutil::SourceLocation location;
+	};
+
+	struct FunctionInfo;
+	struct BasicBlock
+	{
+		/// End of the main code, which stops execution if functions follow.
+		struct MainExit {};
+		struct Jump
+		{
+			BasicBlock* target = nullptr;
+			/// True if this is the back edge of a loop.
+			bool backwards = false;
+		};
+		/// Jumps to @a nonZero if @a condition is non-zero and to @a zero otherwise.
+		struct ConditionalJump
+		{
+			StackSlot condition;
+			BasicBlock* nonZero = nullptr;
+			BasicBlock* zero = nullptr;
+		};
+		struct FunctionReturn
+		{
+			FunctionInfo const* info = nullptr;
+		};
+		/// The last operation of the block never returns.
+		struct Terminated {};
+
+		using Exit = std::variant<MainExit, Jump, ConditionalJump, FunctionReturn, Terminated>;
+
+		std::vector<BasicBlock const*> entries;
+		std::vector<Operation> operations;
+		Exit exit = MainExit{};
+	};
+
+	struct FunctionInfo
+	{
+		FunctionDefinition const* definition = nullptr;
+		Scope::Function const* function = nullptr;
+		BasicBlock* entry = nullptr;
+		std::vector<VariableSlot> parameters;
+		std::vector<VariableSlot> returnVariables;
+	};
+
+	BasicBlock* entry = nullptr;
+	std::map<Scope::Function const*, FunctionInfo> functionInfo;
+	/// Functions in the order of their definitions.
+	std::vector<Scope::Function const*> functions;
+
+	/// Container for the blocks, the pointers to them stay valid.
+	std::list<BasicBlock> blocks;
+	/// Variables that hold the values of switch expressions.
+	std::list<Scope::Variable> ghostVariables;
+	/// Calls to ``eq`` that compare switch expressions to case values.
+	std::list<FunctionCall> ghostCalls;
+
+	BasicBlock& makeBlock() { return blocks.emplace_back(); }
+};
+
+}
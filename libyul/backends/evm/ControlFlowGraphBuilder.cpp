@@ -0,0 +1,429 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Transformation of a Yul AST into a control flow graph.
+ */
+
+#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AsmData.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/Visitor.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::util;
+
+unique_ptr<CFG> ControlFlowGraphBuilder::build(
+	AsmAnalysisInfo const& _analysisInfo,
+	EVMDialect const& _dialect,
+	Block const& _block
+)
+{
+	auto graph = make_unique<CFG>();
+	graph->entry = &graph->makeBlock();
+
+	ControlFlowGraphBuilder builder(*graph, _analysisInfo, _dialect);
+	builder.m_currentBlock = graph->entry;
+	builder(_block);
+	builder.m_currentBlock->exit = CFG::BasicBlock::MainExit{};
+	return graph;
+}
+
+ControlFlowGraphBuilder::ControlFlowGraphBuilder(
+	CFG& _graph,
+	AsmAnalysisInfo const& _analysisInfo,
+	EVMDialect const& _dialect
+):
+	m_graph(_graph),
+	m_info(_analysisInfo),
+	m_dialect(_dialect)
+{
+}
+
+StackSlot ControlFlowGraphBuilder::operator()(Expression const& _expression)
+{
+	return std::visit(GenericVisitor{
+		[&](FunctionCall const& _call) -> StackSlot {
+			Stack output = (*this)(_call);
+			yulAssert(output.size() == 1, "Expected a single return value.");
+			return output.front();
+		},
+		[&](auto const& _value) -> StackSlot { return (*this)(_value); }
+	}, _expression);
+}
+
+StackSlot ControlFlowGraphBuilder::operator()(Literal const& _literal)
+{
+	return LiteralSlot{valueOfLiteral(_literal)};
+}
+
+StackSlot ControlFlowGraphBuilder::operator()(Identifier const& _identifier)
+{
+	return lookupVariable(_identifier.name);
+}
+
+Stack ControlFlowGraphBuilder::operator()(FunctionCall const& _call)
+{
+	BuiltinFunctionForEVM const* builtin = m_dialect.builtin(_call.functionName.name);
+	Scope::Function const* function = nullptr;
+	if (!builtin)
+		yulAssert(m_scope->lookup(_call.functionName.name, GenericVisitor{
+			[](Scope::Variable&) { yulAssert(false, "Expected function name."); },
+			[&](Scope::Function& _function) { function = &_function; }
+		}), "Function name not found.");
+
+	// Arguments are evaluated from right to left. Literal and variable arguments that are
+	// followed by a function call are copied to the stack before that call is evaluated,
+	// so that they do not have to be moved below its return value afterwards.
+	size_t firstCall = _call.arguments.size();
+	for (size_t i = 0; i < _call.arguments.size(); ++i)
+		if (holds_alternative<FunctionCall>(_call.arguments[i]))
+		{
+			firstCall = i;
+			break;
+		}
+
+	Stack input;
+	if (!builtin)
+	{
+		input.emplace_back(FunctionCallReturnLabelSlot{&_call});
+		if (firstCall < _call.arguments.size())
+			m_currentBlock->operations.emplace_back(CFG::Operation{
+				{FunctionCallReturnLabelSlot{&_call}},
+				{FunctionCallReturnLabelSlot{&_call}},
+				CFG::Assignment{},
+				_call.location
+			});
+	}
+	for (size_t i = _call.arguments.size(); i-- > 0;)
+	{
+		if (builtin && builtin->literalArgument(i))
+			continue;
+		StackSlot argument = (*this)(_call.arguments[i]);
+		if (firstCall < i && !holds_alternative<FunctionCall>(_call.arguments[i]))
+		{
+			m_currentBlock->operations.emplace_back(CFG::Operation{
+				{argument},
+				{ArgumentSlot{&_call, i}},
+				CFG::Assignment{},
+				_call.location
+			});
+			argument = ArgumentSlot{&_call, i};
+		}
+		input.emplace_back(move(argument));
+	}
+
+	Stack output;
+	size_t returns = builtin ? builtin->returns.size() : function->returns.size();
+	for (size_t i = 0; i < returns; ++i)
+		output.emplace_back(TemporarySlot{&_call, i});
+	if (builtin)
+		m_currentBlock->operations.emplace_back(CFG::Operation{
+			move(input),
+			output,
+			CFG::BuiltinCall{&_call, builtin},
+			_call.location
+		});
+	else
+		m_currentBlock->operations.emplace_back(CFG::Operation{
+			move(input),
+			output,
+			CFG::UserFunctionCall{&_call, function},
+			_call.location
+		});
+
+	if (builtin && builtin->controlFlowSideEffects.terminates)
+		terminate(CFG::BasicBlock::Terminated{});
+	return output;
+}
+
+void ControlFlowGraphBuilder::operator()(VariableDeclaration const& _varDecl)
+{
+	vector<VariableSlot> variables;
+	for (auto const& variable: _varDecl.variables)
+		variables.emplace_back(lookupVariable(variable.name));
+
+	Stack values;
+	if (!_varDecl.value)
+		values = Stack(variables.size(), LiteralSlot{0});
+	else if (auto const* call = get_if<FunctionCall>(_varDecl.value.get()))
+		values = (*this)(*call);
+	else
+		values = {(*this)(*_varDecl.value)};
+	assign(move(variables), move(values), _varDecl.location);
+}
+
+void ControlFlowGraphBuilder::operator()(Assignment const& _assignment)
+{
+	vector<VariableSlot> variables;
+	for (auto const& variable: _assignment.variableNames)
+		variables.emplace_back(lookupVariable(variable.name));
+
+	Stack values;
+	if (auto const* call = get_if<FunctionCall>(_assignment.value.get()))
+		values = (*this)(*call);
+	else
+		values = {(*this)(*_assignment.value)};
+	assign(move(variables), move(values), _assignment.location);
+}
+
+void ControlFlowGraphBuilder::operator()(ExpressionStatement const& _statement)
+{
+	yulAssert(holds_alternative<FunctionCall>(_statement.expression), "");
+	Stack output = (*this)(std::get<FunctionCall>(_statement.expression));
+	yulAssert(output.empty(), "Discarded return values.");
+}
+
+void ControlFlowGraphBuilder::operator()(Block const& _block)
+{
+	Scope* originalScope = m_scope;
+	m_scope = m_info.scopes.at(&_block).get();
+	visitStatements(_block);
+	m_scope = originalScope;
+}
+
+void ControlFlowGraphBuilder::operator()(If const& _if)
+{
+	StackSlot condition = (*this)(*_if.condition);
+	CFG::BasicBlock& body = m_graph.makeBlock();
+	CFG::BasicBlock& after = m_graph.makeBlock();
+	conditionalJump(move(condition), body, after);
+
+	m_currentBlock = &body;
+	(*this)(_if.body);
+	jump(after);
+	m_currentBlock = &after;
+}
+
+void ControlFlowGraphBuilder::operator()(Switch const& _switch)
+{
+	yulAssert(!_switch.cases.empty(), "");
+	StackSlot expression = (*this)(*_switch.expression);
+	if (holds_alternative<TemporarySlot>(expression))
+	{
+		// Keep the value in a variable that is not visible in the source, so that
+		// it can be compared to every case value.
+		Scope::Variable& ghostVariable = m_graph.ghostVariables.emplace_back(
+			Scope::Variable{_switch.cases.front().value ? _switch.cases.front().value->type : YulString{}}
+		);
+		assign({VariableSlot{&ghostVariable}}, {expression}, _switch.location);
+		expression = VariableSlot{&ghostVariable};
+	}
+
+	CFG::BasicBlock& after = m_graph.makeBlock();
+	for (Case const& switchCase: _switch.cases)
+	{
+		if (!switchCase.value)
+		{
+			(*this)(switchCase.body);
+			break;
+		}
+
+		BuiltinFunctionForEVM const* equality = m_dialect.equalityFunction(switchCase.value->type);
+		yulAssert(equality, "");
+		FunctionCall& ghostCall = m_graph.ghostCalls.emplace_back(FunctionCall{
+			switchCase.location,
+			Identifier{switchCase.location, equality->name},
+			{}
+		});
+		m_currentBlock->operations.emplace_back(CFG::Operation{
+			{LiteralSlot{valueOfLiteral(*switchCase.value)}, expression},
+			{TemporarySlot{&ghostCall, 0}},
+			CFG::BuiltinCall{&ghostCall, equality},
+			switchCase.location
+		});
+
+		CFG::BasicBlock& caseBlock = m_graph.makeBlock();
+		CFG::BasicBlock& next = m_graph.makeBlock();
+		conditionalJump(TemporarySlot{&ghostCall, 0}, caseBlock, next);
+
+		m_currentBlock = &caseBlock;
+		(*this)(switchCase.body);
+		jump(after);
+		m_currentBlock = &next;
+	}
+	jump(after);
+	m_currentBlock = &after;
+}
+
+void ControlFlowGraphBuilder::operator()(ForLoop const& _loop)
+{
+	Scope* originalScope = m_scope;
+	m_scope = m_info.scopes.at(&_loop.pre).get();
+	visitStatements(_loop.pre);
+
+	CFG::BasicBlock& condition = m_graph.makeBlock();
+	CFG::BasicBlock& body = m_graph.makeBlock();
+	CFG::BasicBlock& post = m_graph.makeBlock();
+	CFG::BasicBlock& after = m_graph.makeBlock();
+
+	jump(condition);
+	m_currentBlock = &condition;
+	conditionalJump((*this)(*_loop.condition), body, after);
+
+	optional<ForLoopInfo> originalForLoopInfo = m_forLoopInfo;
+	m_forLoopInfo = ForLoopInfo{&post, &after};
+	m_currentBlock = &body;
+	(*this)(_loop.body);
+	jump(post);
+	m_forLoopInfo = originalForLoopInfo;
+
+	m_currentBlock = &post;
+	(*this)(_loop.post);
+	jump(condition, true);
+
+	m_currentBlock = &after;
+	m_scope = originalScope;
+}
+
+void ControlFlowGraphBuilder::operator()(Break const&)
+{
+	yulAssert(m_forLoopInfo, "");
+	jump(*m_forLoopInfo->after);
+	m_currentBlock = &m_graph.makeBlock();
+}
+
+void ControlFlowGraphBuilder::operator()(Continue const&)
+{
+	yulAssert(m_forLoopInfo, "");
+	jump(*m_forLoopInfo->post);
+	m_currentBlock = &m_graph.makeBlock();
+}
+
+void ControlFlowGraphBuilder::operator()(Leave const&)
+{
+	yulAssert(m_currentFunction, "");
+	terminate(CFG::BasicBlock::FunctionReturn{m_currentFunction});
+}
+
+void ControlFlowGraphBuilder::operator()(FunctionDefinition const& _function)
+{
+	yulAssert(m_scope, "");
+	yulAssert(m_scope->identifiers.count(_function.name), "");
+	Scope::Function const& function = std::get<Scope::Function>(m_scope->identifiers.at(_function.name));
+	Scope* virtualScope = m_info.scopes.at(m_info.virtualBlocks.at(&_function).get()).get();
+	yulAssert(virtualScope, "");
+
+	CFG::FunctionInfo& info = m_graph.functionInfo[&function];
+	m_graph.functions.emplace_back(&function);
+	info.definition = &_function;
+	info.function = &function;
+	info.entry = &m_graph.makeBlock();
+	for (auto const& parameter: _function.parameters)
+		info.parameters.emplace_back(VariableSlot{
+			&std::get<Scope::Variable>(virtualScope->identifiers.at(parameter.name))
+		});
+	for (auto const& returnVariable: _function.returnVariables)
+		info.returnVariables.emplace_back(VariableSlot{
+			&std::get<Scope::Variable>(virtualScope->identifiers.at(returnVariable.name))
+		});
+
+	CFG::BasicBlock* originalBlock = m_currentBlock;
+	Scope* originalScope = m_scope;
+	CFG::FunctionInfo* originalFunction = m_currentFunction;
+	optional<ForLoopInfo> originalForLoopInfo = m_forLoopInfo;
+	m_currentBlock = info.entry;
+	m_scope = virtualScope;
+	m_currentFunction = &info;
+	m_forLoopInfo = nullopt;
+
+	if (!info.returnVariables.empty())
+		assign(info.returnVariables, Stack(info.returnVariables.size(), LiteralSlot{0}), _function.location);
+	(*this)(_function.body);
+	m_currentBlock->exit = CFG::BasicBlock::FunctionReturn{&info};
+
+	m_currentBlock = originalBlock;
+	m_scope = originalScope;
+	m_currentFunction = originalFunction;
+	m_forLoopInfo = originalForLoopInfo;
+}
+
+void ControlFlowGraphBuilder::visitStatements(Block const& _block)
+{
+	for (auto const& statement: _block.statements)
+		std::visit(*this, statement);
+}
+
+void ControlFlowGraphBuilder::assign(
+	vector<VariableSlot> _variables,
+	Stack _values,
+	langutil::SourceLocation const& _location
+)
+{
+	yulAssert(_variables.size() == _values.size(), "");
+	Stack output(_variables.begin(), _variables.end());
+	m_currentBlock->operations.emplace_back(CFG::Operation{
+		move(_values),
+		move(output),
+		CFG::Assignment{move(_variables)},
+		_location
+	});
+}
+
+VariableSlot ControlFlowGraphBuilder::lookupVariable(YulString _name) const
+{
+	yulAssert(m_scope, "");
+	Scope::Variable const* variable = nullptr;
+	yulAssert(m_scope->lookup(_name, GenericVisitor{
+		[&](Scope::Variable& _variable) { variable = &_variable; },
+		[](Scope::Function&) { yulAssert(false, "Expected variable name."); }
+	}), "Variable name not found.");
+	return VariableSlot{variable};
+}
+
+void ControlFlowGraphBuilder::jump(CFG::BasicBlock& _target, bool _backwards)
+{
+	m_currentBlock->exit = CFG::BasicBlock::Jump{&_target, _backwards};
+	if (isReachable())
+		_target.entries.emplace_back(m_currentBlock);
+}
+
+void ControlFlowGraphBuilder::conditionalJump(StackSlot _condition, CFG::BasicBlock& _nonZero, CFG::BasicBlock& _zero)
+{
+	if (auto const* literal = get_if<LiteralSlot>(&_condition))
+	{
+		jump(literal->value != 0 ? _nonZero : _zero);
+		return;
+	}
+	m_currentBlock->exit = CFG::BasicBlock::ConditionalJump{move(_condition), &_nonZero, &_zero};
+	if (isReachable())
+	{
+		_nonZero.entries.emplace_back(m_currentBlock);
+		_zero.entries.emplace_back(m_currentBlock);
+	}
+}
+
+bool ControlFlowGraphBuilder::isReachable() const
+{
+	return
+		!m_currentBlock->entries.empty() ||
+		m_currentBlock == m_graph.entry ||
+		(m_currentFunction && m_currentBlock == m_currentFunction->entry);
+}
+
+void ControlFlowGraphBuilder::terminate(CFG::BasicBlock::Exit _exit)
+{
+	m_currentBlock->exit = move(_exit);
+	m_currentBlock = &m_graph.makeBlock();
+}
@@ -0,0 +1,96 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Transformation of a Yul AST into a control flow graph.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/ControlFlowGraph.h>
+
+#include <memory>
+#include <optional>
+
+namespace solidity::yul
+{
+
+struct AsmAnalysisInfo;
+struct EVMDialect;
+
+/**
+ * Builds the control flow graph of a Yul block, see CFG.
+ * The block has to be analyzed and its analysis info has to be passed in.
+ */
+class ControlFlowGraphBuilder
+{
+public:
+	ControlFlowGraphBuilder(ControlFlowGraphBuilder const&) = delete;
+	ControlFlowGraphBuilder& operator=(ControlFlowGraphBuilder const&) = delete;
+	static std::unique_ptr<CFG> build(AsmAnalysisInfo const& _analysisInfo, EVMDialect const& _dialect, Block const& _block);
+
+	StackSlot operator()(Expression const& _expression);
+	StackSlot operator()(Literal const& _literal);
+	StackSlot operator()(Identifier const& _identifier);
+	Stack operator()(FunctionCall const& _call);
+
+	void operator()(VariableDeclaration const& _varDecl);
+	void operator()(Assignment const& _assignment);
+	void operator()(ExpressionStatement const& _statement);
+	void operator()(Block const& _block);
+	void operator()(If const& _if);
+	void operator()(Switch const& _switch);
+	void operator()(ForLoop const& _forLoop);
+	void operator()(Break const& _break);
+	void operator()(Continue const& _continue);
+	void operator()(Leave const& _leave);
+	void operator()(FunctionDefinition const& _function);
+
+private:
+	ControlFlowGraphBuilder(CFG& _graph, AsmAnalysisInfo const& _analysisInfo, EVMDialect const& _dialect);
+
+	void visitStatements(Block const& _block);
+	/// Appends an operation to the current block that moves @a _values into fresh stack slots
+	/// for @a _variables.
+	void assign(std::vector<VariableSlot> _variables, Stack _values, langutil::SourceLocation const& _location);
+	VariableSlot lookupVariable(YulString _name) const;
+
+	void jump(CFG::BasicBlock& _target, bool _backwards = false);
+	/// Ends the current block with a jump to @a _nonZero or @a _zero depending on @a _condition.
+	void conditionalJump(StackSlot _condition, CFG::BasicBlock& _nonZero, CFG::BasicBlock& _zero);
+	/// @returns false if the current block cannot be reached, for example because it follows
+	/// a terminating statement. Jumps from unreachable blocks are not recorded as entries.
+	bool isReachable() const;
+	/// Ends the current block without a successor and continues in a fresh, unreachable block.
+	void terminate(CFG::BasicBlock::Exit _exit);
+
+	CFG& m_graph;
+	AsmAnalysisInfo const& m_info;
+	EVMDialect const& m_dialect;
+	CFG::BasicBlock* m_currentBlock = nullptr;
+	Scope* m_scope = nullptr;
+	CFG::FunctionInfo* m_currentFunction = nullptr;
+
+	struct ForLoopInfo
+	{
+		CFG::BasicBlock* post = nullptr;
+		CFG::BasicBlock* after = nullptr;
+	};
+	std::optional<ForLoopInfo> m_forLoopInfo;
+};
+
+}
@@ -26,10 +26,13 @@
 #include <libyul/AsmData.h>
 #include <libyul/Utilities.h>
 
+#include <libevmasm/GasMeter.h>
+
 #include <liblangutil/Exceptions.h>
 
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <algorithm>
 #include <utility>
 #include <variant>
 
@@ -104,6 +107,7 @@ CodeTransform::CodeTransform(
 	bool _evm15,
 	ExternalIdentifierAccess _identifierAccess,
 	bool _useNamedLabelsForFunctions,
+	optional<size_t> _expectedExecutionsPerDeployment,
 	shared_ptr<Context> _context
 ):
 	m_assembly(_assembly),
@@ -113,6 +117,7 @@ CodeTransform::CodeTransform(
 	m_allowStackOpt(_allowStackOpt),
 	m_evm15(_evm15),
 	m_useNamedLabelsForFunctions(_useNamedLabelsForFunctions),
+	m_expectedExecutionsPerDeployment(_expectedExecutionsPerDeployment),
 	m_identifierAccess(std::move(_identifierAccess)),
 	m_context(std::move(_context))
 {
@@ -361,23 +366,43 @@ void CodeTransform::operator()(Switch const& _switch)
 	int expressionHeight = m_assembly.stackHeight();
 	map<Case const*, AbstractAssembly::LabelID> caseBodies;
 	AbstractAssembly::LabelID end = m_assembly.newLabelId();
+
+	vector<pair<u256, Case const*>> valueCases;
 	for (Case const& c: _switch.cases)
-	{
 		if (c.value)
+			valueCases.emplace_back(valueOfLiteral(*c.value), &c);
+
+	if (splitSwitchCases(valueCases.size()))
+	{
+		for (auto const& c: valueCases)
+			caseBodies[c.second] = m_assembly.newLabelId();
+		AbstractAssembly::LabelID defaultLabel = m_assembly.newLabelId();
+		sort(valueCases.begin(), valueCases.end());
+		appendSwitchSearch(_switch, valueCases, 0, valueCases.size(), caseBodies, defaultLabel, true);
+		yulAssert(m_assembly.stackHeight() == expressionHeight, "");
+		m_assembly.setSourceLocation(_switch.location);
+		m_assembly.appendLabel(defaultLabel);
+		if (!_switch.cases.back().value)
+			(*this)(_switch.cases.back().body);
+	}
+	else
+		for (Case const& c: _switch.cases)
 		{
-			(*this)(*c.value);
-			m_assembly.setSourceLocation(c.location);
-			AbstractAssembly::LabelID bodyLabel = m_assembly.newLabelId();
-			caseBodies[&c] = bodyLabel;
-			yulAssert(m_assembly.stackHeight() == expressionHeight + 1, "");
-			m_assembly.appendInstruction(evmasm::dupInstruction(2));
-			m_assembly.appendInstruction(evmasm::Instruction::EQ);
-			m_assembly.appendJumpToIf(bodyLabel);
+			if (c.value)
+			{
+				(*this)(*c.value);
+				m_assembly.setSourceLocation(c.location);
+				AbstractAssembly::LabelID bodyLabel = m_assembly.newLabelId();
+				caseBodies[&c] = bodyLabel;
+				yulAssert(m_assembly.stackHeight() == expressionHeight + 1, "");
+				m_assembly.appendInstruction(evmasm::dupInstruction(2));
+				m_assembly.appendInstruction(evmasm::Instruction::EQ);
+				m_assembly.appendJumpToIf(bodyLabel);
+			}
+			else
+				// default case
+				(*this)(c.body);
 		}
-		else
-			// default case
-			(*this)(c.body);
-	}
 	m_assembly.setSourceLocation(_switch.location);
 	m_assembly.appendJumpTo(end);
 
@@ -400,6 +425,64 @@ void CodeTransform::operator()(Switch const& _switch)
 	m_assembly.appendInstruction(evmasm::Instruction::POP);
 }
 
+bool CodeTransform::splitSwitchCases(size_t _numCases) const
+{
+	if (!m_expectedExecutionsPerDeployment || _numCases <= 4)
+		return false;
+
+	// This uses the cost model of ContractCompiler::appendInternalSelector:
+	// A split costs about 17 bytes of code and saves about 6 * (n - 4) gas
+	// per execution on average.
+	size_t const runs = *m_expectedExecutionsPerDeployment;
+	// Start with a comparison that avoids overflow.
+	if (runs > (17 * evmasm::GasCosts::createDataGas) / 6)
+		return true;
+	return runs * 6 * (_numCases - 4) > 17 * evmasm::GasCosts::createDataGas;
+}
+
+void CodeTransform::appendSwitchSearch(
+	Switch const& _switch,
+	vector<pair<u256, Case const*>> const& _cases,
+	size_t _begin,
+	size_t _end,
+	map<Case const*, AbstractAssembly::LabelID> const& _caseBodies,
+	AbstractAssembly::LabelID _default,
+	bool _isLast
+)
+{
+	if (splitSwitchCases(_end - _begin))
+	{
+		size_t middle = _begin + (_end - _begin) / 2;
+		AbstractAssembly::LabelID upperHalf = m_assembly.newLabelId();
+		m_assembly.setSourceLocation(_switch.location);
+		m_assembly.appendConstant(_cases[middle - 1].first);
+		m_assembly.appendInstruction(evmasm::dupInstruction(2));
+		m_assembly.appendInstruction(evmasm::Instruction::GT);
+		m_assembly.appendJumpToIf(upperHalf);
+		appendSwitchSearch(_switch, _cases, _begin, middle, _caseBodies, _default, false);
+		m_assembly.setSourceLocation(_switch.location);
+		m_assembly.appendLabel(upperHalf);
+		appendSwitchSearch(_switch, _cases, middle, _end, _caseBodies, _default, _isLast);
+		return;
+	}
+
+	for (size_t i = _begin; i < _end; ++i)
+	{
+		Case const& c = *_cases[i].second;
+		(*this)(*c.value);
+		m_assembly.setSourceLocation(c.location);
+		m_assembly.appendInstruction(evmasm::dupInstruction(2));
+		m_assembly.appendInstruction(evmasm::Instruction::EQ);
+		m_assembly.appendJumpToIf(_caseBodies.at(&c));
+	}
+	// The default label directly follows the last range.
+	if (!_isLast)
+	{
+		m_assembly.setSourceLocation(_switch.location);
+		m_assembly.appendJumpTo(_default);
+	}
+}
+
 void CodeTransform::operator()(FunctionDefinition const& _function)
 {
 	yulAssert(m_scope, "");
@@ -447,6 +530,7 @@ void CodeTransform::operator()(FunctionDefinition const& _function)
 		m_evm15,
 		m_identifierAccess,
 		m_useNamedLabelsForFunctions,
+		m_expectedExecutionsPerDeployment,
 		m_context
 	);
 	subTransform(_function.body);
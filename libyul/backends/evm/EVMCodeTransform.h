@@ -115,6 +115,8 @@ public:
 	/// given assembly.
 	/// Throws StackTooDeepError if a variable is not accessible or if a function has too
 	/// many parameters.
+	/// @param _expectedExecutionsPerDeployment if set, large switch statements are translated
+	/// into a binary search if that is cheaper for the given number of executions.
 	CodeTransform(
 		AbstractAssembly& _assembly,
 		AsmAnalysisInfo& _analysisInfo,
@@ -124,7 +126,8 @@ public:
 		bool _allowStackOpt = false,
 		bool _evm15 = false,
 		ExternalIdentifierAccess const& _identifierAccess = ExternalIdentifierAccess(),
-		bool _useNamedLabelsForFunctions = false
+		bool _useNamedLabelsForFunctions = false,
+		std::optional<size_t> _expectedExecutionsPerDeployment = std::nullopt
 	): CodeTransform(
 		_assembly,
 		_analysisInfo,
@@ -135,6 +138,7 @@ public:
 		_evm15,
 		_identifierAccess,
 		_useNamedLabelsForFunctions,
+		_expectedExecutionsPerDeployment,
 		nullptr
 	)
 	{
@@ -155,6 +159,7 @@ protected:
 		bool _evm15,
 		ExternalIdentifierAccess _identifierAccess,
 		bool _useNamedLabelsForFunctions,
+		std::optional<size_t> _expectedExecutionsPerDeployment,
 		std::shared_ptr<Context> _context
 	);
 
@@ -192,6 +197,22 @@ private:
 
 	void visitStatements(std::vector<Statement> const& _statements);
 
+	/// @returns true if it is cheaper to select from @a _numCases switch cases by first
+	/// comparing against a pivot value than by comparing against each value in turn.
+	bool splitSwitchCases(size_t _numCases) const;
+	/// Appends a binary search for the switch value on top of the stack among the cases
+	/// [_begin, _end) of @a _cases, which are sorted by value. Jumps to the body of the
+	/// matching case or to @a _default. The jump to @a _default is omitted for the last range.
+	void appendSwitchSearch(
+		Switch const& _switch,
+		std::vector<std::pair<u256, Case const*>> const& _cases,
+		size_t _begin,
+		size_t _end,
+		std::map<Case const*, AbstractAssembly::LabelID> const& _caseBodies,
+		AbstractAssembly::LabelID _default,
+		bool _isLast
+	);
+
 	/// Pops all variables declared in the block and checks that the stack height is equal
 	/// to @a _blockStartStackHeight.
 	void finalizeBlock(Block const& _block, int _blockStartStackHeight);
@@ -224,6 +245,7 @@ private:
 	bool const m_allowStackOpt = true;
 	bool const m_evm15 = false;
 	bool const m_useNamedLabelsForFunctions = false;
+	std::optional<size_t> const m_expectedExecutionsPerDeployment;
 	ExternalIdentifierAccess m_identifierAccess;
 	std::shared_ptr<Context> m_context;
 
@@ -23,6 +23,8 @@
 
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/NoOutputAssembly.h>
+#include <libyul/backends/evm/OptimizedEVMCodeTransform.h>
 
 #include <libyul/Object.h>
 #include <libyul/Exceptions.h>
@@ -31,9 +33,17 @@
 using namespace solidity::yul;
 using namespace std;
 
-void EVMObjectCompiler::compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15, bool _optimize)
+void EVMObjectCompiler::compile(
+	Object& _object,
+	AbstractAssembly& _assembly,
+	EVMDialect const& _dialect,
+	bool _evm15,
+	bool _optimize,
+	optional<size_t> _expectedExecutionsPerDeployment,
+	bool _optimizeStackLayout
+)
 {
-	EVMObjectCompiler compiler(_assembly, _dialect, _evm15);
+	EVMObjectCompiler compiler(_assembly, _dialect, _evm15, _expectedExecutionsPerDeployment, _optimizeStackLayout);
 	compiler.run(_object, _optimize);
 }
 
@@ -48,7 +58,15 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 			auto subAssemblyAndID = m_assembly.createSubAssembly();
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
 			subObject->subId = subAssemblyAndID.second;
-			compile(*subObject, *subAssemblyAndID.first, m_dialect, m_evm15, _optimize);
+			compile(
+				*subObject,
+				*subAssemblyAndID.first,
+				m_dialect,
+				m_evm15,
+				_optimize,
+				m_expectedExecutionsPerDeployment,
+				m_optimizeStackLayout
+			);
 		}
 		else
 		{
@@ -58,9 +76,41 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 
 	yulAssert(_object.analysisInfo, "No analysis info.");
 	yulAssert(_object.code, "No code.");
+	if (m_optimizeStackLayout && !m_evm15)
+	{
+		// Only use the new code transform if it does not run into stack errors,
+		// which is checked by generating the code without output first.
+		bool stackTooDeep = false;
+		try
+		{
+			NoOutputAssembly assembly;
+			OptimizedEVMCodeTransform::run(assembly, *_object.analysisInfo, *_object.code, m_dialect, context);
+		}
+		catch (StackTooDeepError const&)
+		{
+			stackTooDeep = true;
+		}
+		if (!stackTooDeep)
+		{
+			OptimizedEVMCodeTransform::run(m_assembly, *_object.analysisInfo, *_object.code, m_dialect, context);
+			return;
+		}
+	}
+
 	// We do not catch and re-throw the stack too deep exception here because it is a YulException,
 	// which should be native to this part of the code.
-	CodeTransform transform{m_assembly, *_object.analysisInfo, *_object.code, m_dialect, context, _optimize, m_evm15};
+	CodeTransform transform{
+		m_assembly,
+		*_object.analysisInfo,
+		*_object.code,
+		m_dialect,
+		context,
+		_optimize,
+		m_evm15,
+		ExternalIdentifierAccess{},
+		false,
+		m_expectedExecutionsPerDeployment
+	};
 	transform(*_object.code);
 	if (!transform.stackErrors().empty())
 		BOOST_THROW_EXCEPTION(transform.stackErrors().front());
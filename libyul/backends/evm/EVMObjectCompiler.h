@@ -21,6 +21,9 @@
 
 #pragma once
 
+#include <cstddef>
+#include <optional>
+
 namespace solidity::yul
 {
 struct Object;
@@ -30,10 +33,32 @@ struct EVMDialect;
 class EVMObjectCompiler
 {
 public:
-	static void compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15, bool _optimize);
+	/// @param _expectedExecutionsPerDeployment if set, used to decide whether switch statements
+	/// are translated into a binary search.
+	/// @param _optimizeStackLayout if true, code is generated by OptimizedEVMCodeTransform,
+	/// falling back to CodeTransform if that runs out of reachable stack slots.
+	static void compile(
+		Object& _object,
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		bool _evm15,
+		bool _optimize,
+		std::optional<size_t> _expectedExecutionsPerDeployment = std::nullopt,
+		bool _optimizeStackLayout = false
+	);
 private:
-	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15):
-		m_assembly(_assembly), m_dialect(_dialect), m_evm15(_evm15)
+	EVMObjectCompiler(
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		bool _evm15,
+		std::optional<size_t> _expectedExecutionsPerDeployment,
+		bool _optimizeStackLayout
+	):
+		m_assembly(_assembly),
+		m_dialect(_dialect),
+		m_evm15(_evm15),
+		m_expectedExecutionsPerDeployment(_expectedExecutionsPerDeployment),
+		m_optimizeStackLayout(_optimizeStackLayout)
 	{}
 
 	void run(Object& _object, bool _optimize);
@@ -41,6 +66,8 @@ private:
 	AbstractAssembly& m_assembly;
 	EVMDialect const& m_dialect;
 	bool m_evm15 = false;
+	std::optional<size_t> m_expectedExecutionsPerDeployment;
+	bool m_optimizeStackLayout = false;
 };
 
 }
@@ -0,0 +1,567 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Code generator for translating Yul to EVM that chooses stack layouts based on liveness.
+ */
+
+#include <libyul/backends/evm/OptimizedEVMCodeTransform.h>
+
+#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/EVMCodeTransform.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmData.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Utilities.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+#include <boost/range/adaptor/reversed.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::util;
+
+namespace
+{
+
+bool isJunk(StackSlot const& _slot)
+{
+	return holds_alternative<JunkSlot>(_slot);
+}
+
+/// Inserts @a _slot into @a _live unless it can be pushed whenever it is needed.
+void addLive(set<StackSlot>& _live, StackSlot const& _slot)
+{
+	if (!holds_alternative<LiteralSlot>(_slot) && !isJunk(_slot))
+		_live.insert(_slot);
+}
+
+/// @returns the slots that are live before @a _operation given the slots live after it.
+set<StackSlot> liveBefore(CFG::Operation const& _operation, set<StackSlot> _live)
+{
+	for (StackSlot const& slot: _operation.output)
+		_live.erase(slot);
+	for (StackSlot const& slot: _operation.input)
+		addLive(_live, slot);
+	return _live;
+}
+
+/// @returns the first occurrence of each slot of @a _stack that is in @a _live, in stack order.
+Stack filterLive(Stack const& _stack, set<StackSlot> const& _live)
+{
+	Stack result;
+	set<StackSlot> seen;
+	for (StackSlot const& slot: _stack)
+		if (_live.count(slot) && seen.insert(slot).second)
+			result.emplace_back(slot);
+	yulAssert(seen.size() == _live.size(), "Live slot missing from the stack.");
+	return result;
+}
+
+/// @returns @a _stack with all slots that are not live or occur a second time replaced by junk.
+Stack junkUnlessLive(Stack _stack, set<StackSlot> const& _live)
+{
+	set<StackSlot> seen;
+	for (StackSlot& slot: _stack)
+		if (!_live.count(slot) || !seen.insert(slot).second)
+			slot = JunkSlot{};
+	return _stack;
+}
+
+size_t countFrom(Stack const& _stack, size_t _from, StackSlot const& _slot)
+{
+	if (_from >= _stack.size())
+		return 0;
+	return static_cast<size_t>(count(_stack.begin() + static_cast<ptrdiff_t>(_from), _stack.end(), _slot));
+}
+
+/**
+ * Transforms @a _current into @a _target position by position from the bottom, calling
+ * @a _swap, @a _dup, @a _push and @a _pop for each stack manipulation. Junk slots
+ * in the target match any value. Values that are not needed anymore are popped as soon as
+ * they are on top. Slots that are missing are duplicated or, if they are literals or
+ * return labels, pushed.
+ */
+template <typename Swap, typename Dup, typename Push, typename Pop>
+void shuffleStack(Stack& _current, Stack const& _target, Swap _swap, Dup _dup, Push _push, Pop _pop)
+{
+	auto isSurplus = [&](size_t _position) {
+		StackSlot const& top = _current.back();
+		if (_current.size() <= _target.size() && isJunk(_target[_current.size() - 1]))
+			return false;
+		return isJunk(top) || countFrom(_current, _position, top) > countFrom(_target, _position, top);
+	};
+	auto bring = [&](StackSlot const& _slot) {
+		if (holds_alternative<LiteralSlot>(_slot))
+			_push(_slot);
+		else if (isJunk(_slot) && !_current.empty())
+			_dup(1u);
+		else
+		{
+			auto occurrence = find(_current.rbegin(), _current.rend(), _slot);
+			size_t depth = static_cast<size_t>(occurrence - _current.rbegin()) + 1;
+			if (occurrence != _current.rend() && (depth <= 16 || !holds_alternative<FunctionCallReturnLabelSlot>(_slot)))
+				_dup(depth);
+			else
+			{
+				yulAssert(holds_alternative<FunctionCallReturnLabelSlot>(_slot) || isJunk(_slot), "Slot not on the stack.");
+				_push(_slot);
+			}
+		}
+		_current.emplace_back(_slot);
+	};
+	auto swap = [&](size_t _depth) {
+		_swap(_depth);
+		std::swap(_current.back(), _current[_current.size() - 1 - _depth]);
+	};
+
+	for (size_t position = 0; ; )
+	{
+		while (_current.size() > position && isSurplus(position))
+		{
+			_pop();
+			_current.pop_back();
+		}
+		if (position == _target.size())
+		{
+			while (_current.size() > position)
+			{
+				_pop();
+				_current.pop_back();
+			}
+			break;
+		}
+		if (position == _current.size())
+			bring(_target[position]);
+		else if (!isJunk(_target[position]) && !(_current[position] == _target[position]))
+		{
+			size_t source = _current.size();
+			for (size_t i = _current.size() - 1; i > position; --i)
+				if (_current[i] == _target[position])
+				{
+					source = i;
+					break;
+				}
+			if (source == _current.size())
+			{
+				bring(_target[position]);
+				source = _current.size() - 1;
+			}
+			size_t top = _current.size() - 1;
+			if (source != top)
+				swap(top - source);
+			swap(top - position);
+		}
+		++position;
+	}
+}
+
+/// @returns the number of instructions needed to create @a _target from @a _current
+/// or nullopt if a slot would be too deep in the stack.
+optional<size_t> stackLayoutCost(Stack _current, Stack const& _target)
+{
+	bool reachable = true;
+	size_t cost = 0;
+	auto checkDepth = [&](size_t _depth) { reachable = reachable && _depth <= 16; ++cost; };
+	shuffleStack(_current, _target, checkDepth, checkDepth, [&](StackSlot const&) { ++cost; }, [&]() { ++cost; });
+	if (!reachable)
+		return nullopt;
+	return cost;
+}
+
+}
+
+void OptimizedEVMCodeTransform::run(
+	AbstractAssembly& _assembly,
+	AsmAnalysisInfo const& _analysisInfo,
+	Block const& _block,
+	EVMDialect const& _dialect,
+	BuiltinContext& _builtinContext,
+	bool _useNamedLabelsForFunctions
+)
+{
+	unique_ptr<CFG> graph = ControlFlowGraphBuilder::build(_analysisInfo, _dialect, _block);
+	OptimizedEVMCodeTransform transform(_assembly, _builtinContext, *graph, _useNamedLabelsForFunctions);
+	transform.computeLiveness();
+
+	transform.generate(*graph->entry, {}, false);
+	for (Scope::Function const* function: graph->functions)
+	{
+		CFG::FunctionInfo const& info = graph->functionInfo.at(function);
+		transform.m_currentFunction = &info;
+		transform.m_blockInfo[info.entry].label = transform.functionLabel(*function);
+
+		// The return label is below the arguments, the first argument is on top.
+		Stack layout{FunctionReturnLabelSlot{}};
+		for (VariableSlot const& parameter: info.parameters | boost::adaptors::reversed)
+			layout.emplace_back(parameter);
+		_assembly.setSourceLocation(info.definition->location);
+		transform.generate(*info.entry, move(layout), true);
+	}
+}
+
+OptimizedEVMCodeTransform::OptimizedEVMCodeTransform(
+	AbstractAssembly& _assembly,
+	BuiltinContext& _builtinContext,
+	CFG const& _graph,
+	bool _useNamedLabelsForFunctions
+):
+	m_assembly(_assembly),
+	m_builtinContext(_builtinContext),
+	m_graph(_graph),
+	m_useNamedLabelsForFunctions(_useNamedLabelsForFunctions)
+{
+}
+
+void OptimizedEVMCodeTransform::computeLiveness()
+{
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (CFG::BasicBlock const& block: m_graph.blocks | boost::adaptors::reversed)
+		{
+			set<StackSlot> live = requiredAtExit(block);
+			for (CFG::Operation const& operation: block.operations | boost::adaptors::reversed)
+				live = liveBefore(operation, move(live));
+			// Return labels are pushed when needed and never live across blocks.
+			for (auto it = live.begin(); it != live.end();)
+				if (holds_alternative<FunctionCallReturnLabelSlot>(*it))
+					it = live.erase(it);
+				else
+					++it;
+			set<StackSlot>& liveIn = m_liveIn[&block];
+			if (live != liveIn)
+			{
+				liveIn = move(live);
+				changed = true;
+			}
+		}
+	}
+}
+
+set<StackSlot> OptimizedEVMCodeTransform::requiredAtExit(CFG::BasicBlock const& _block) const
+{
+	auto liveIn = [&](CFG::BasicBlock const* _target) {
+		auto it = m_liveIn.find(_target);
+		return it == m_liveIn.end() ? set<StackSlot>{} : it->second;
+	};
+	return std::visit(GenericVisitor{
+		[&](CFG::BasicBlock::Jump const& _jump) { return liveIn(_jump.target); },
+		[&](CFG::BasicBlock::ConditionalJump const& _jump) {
+			set<StackSlot> live = liveIn(_jump.nonZero);
+			live += liveIn(_jump.zero);
+			addLive(live, _jump.condition);
+			return live;
+		},
+		[&](CFG::BasicBlock::FunctionReturn const& _return) {
+			set<StackSlot> live{FunctionReturnLabelSlot{}};
+			for (VariableSlot const& returnVariable: _return.info->returnVariables)
+				live.insert(returnVariable);
+			return live;
+		},
+		[&](auto const&) { return set<StackSlot>{}; }
+	}, _block.exit);
+}
+
+void OptimizedEVMCodeTransform::generate(CFG::BasicBlock const& _entry, Stack _layout, bool _needsLabel)
+{
+	m_blockInfo[&_entry].entryLayout = move(_layout);
+	generateBlocks(_entry, _needsLabel);
+	while (!m_stagedBlocks.empty())
+	{
+		CFG::BasicBlock const* block = m_stagedBlocks.front();
+		m_stagedBlocks.pop_front();
+		if (!m_blockInfo[block].generated)
+			generateBlocks(*block, true);
+	}
+}
+
+void OptimizedEVMCodeTransform::generateBlocks(CFG::BasicBlock const& _block, bool _needsLabel)
+{
+	for (CFG::BasicBlock const* block = &_block; block; _needsLabel = false)
+	{
+		BlockInfo& info = m_blockInfo[block];
+		yulAssert(!info.generated && info.entryLayout, "");
+		info.generated = true;
+
+		// Blocks that are only reached by falling through do not need a label.
+		if (_needsLabel || block->entries.size() > 1)
+			m_assembly.appendLabel(blockLabel(*block));
+		m_stack = *info.entryLayout;
+		m_assembly.setStackHeight(static_cast<int>(m_stack.size()));
+
+		vector<set<StackSlot>> liveAfter(block->operations.size());
+		set<StackSlot> live = requiredAtExit(*block);
+		for (size_t i = block->operations.size(); i-- > 0;)
+		{
+			liveAfter[i] = live;
+			live = liveBefore(block->operations[i], move(live));
+		}
+		for (size_t i = 0; i < block->operations.size(); ++i)
+			(*this)(block->operations[i], liveAfter[i]);
+
+		block = generateExit(*block);
+	}
+}
+
+void OptimizedEVMCodeTransform::operator()(CFG::Operation const& _operation, set<StackSlot> const& _liveAfter)
+{
+	m_assembly.setSourceLocation(_operation.location);
+	auto isLive = [&](StackSlot const& _slot) { return _liveAfter.count(_slot) > 0; };
+	auto isOutput = [&](StackSlot const& _slot) {
+		return find(_operation.output.begin(), _operation.output.end(), _slot) != _operation.output.end();
+	};
+
+	if (auto const* assignment = get_if<CFG::Assignment>(&_operation.operation))
+		if (
+			!assignment->variables.empty() &&
+			none_of(_operation.output.begin(), _operation.output.end(), isLive) &&
+			all_of(_operation.input.begin(), _operation.input.end(), [](StackSlot const& _slot) {
+				return holds_alternative<VariableSlot>(_slot) || holds_alternative<LiteralSlot>(_slot);
+			})
+		)
+		{
+			// Nothing has to be generated for an assignment that is never read.
+			for (StackSlot& slot: m_stack)
+				if (isOutput(slot))
+					slot = JunkSlot{};
+			return;
+		}
+
+	// Keep the live values where they are, the arguments go on top.
+	Stack target;
+	Stack compressedTarget;
+	set<StackSlot> kept;
+	for (StackSlot const& slot: m_stack)
+		if (isLive(slot) && !isOutput(slot) && kept.insert(slot).second)
+		{
+			target.emplace_back(slot);
+			compressedTarget.emplace_back(slot);
+		}
+		else
+			target.emplace_back(JunkSlot{});
+	// If the arguments are already on top, the values below them can also be left
+	// in place and removed later.
+	optional<Stack> inPlaceTarget;
+	if (
+		m_stack.size() >= _operation.input.size() &&
+		all_of(target.begin() + static_cast<ptrdiff_t>(m_stack.size() - _operation.input.size()), target.end(), isJunk)
+	)
+	{
+		inPlaceTarget = Stack(target.begin(), target.end() - static_cast<ptrdiff_t>(_operation.input.size()));
+		*inPlaceTarget += _operation.input;
+	}
+	while (!target.empty() && isJunk(target.back()))
+		target.pop_back();
+	target += _operation.input;
+	compressedTarget += _operation.input;
+
+	optional<size_t> cost = stackLayoutCost(m_stack, target);
+	if (inPlaceTarget)
+		if (optional<size_t> inPlaceCost = stackLayoutCost(m_stack, *inPlaceTarget))
+			if (!cost || *inPlaceCost < *cost)
+			{
+				target = move(*inPlaceTarget);
+				cost = inPlaceCost;
+			}
+	if (!cost)
+		target = move(compressedTarget);
+	createStackLayout(target);
+
+	int const expectedHeight =
+		static_cast<int>(m_stack.size()) +
+		static_cast<int>(_operation.output.size()) -
+		static_cast<int>(_operation.input.size());
+	std::visit(GenericVisitor{
+		[&](CFG::BuiltinCall const& _call) {
+			_call.builtin->generateCode(
+				*_call.call,
+				m_assembly,
+				m_builtinContext,
+				[&](Expression const& _argument) {
+					// Only literal arguments are not on the stack already.
+					size_t index = static_cast<size_t>(&_argument - _call.call->arguments.data());
+					yulAssert(index < _call.call->arguments.size(), "");
+					if (_call.builtin->literalArgument(index))
+						m_assembly.appendConstant(valueOfLiteral(std::get<Literal>(_argument)));
+				}
+			);
+		},
+		[&](CFG::UserFunctionCall const& _call) {
+			m_assembly.appendJumpTo(
+				functionLabel(*_call.function),
+				static_cast<int>(_operation.output.size()) - static_cast<int>(_operation.input.size()),
+				AbstractAssembly::JumpType::IntoFunction
+			);
+			m_assembly.appendLabel(returnLabel(*_call.call));
+		},
+		[&](CFG::Assignment const&) {}
+	}, _operation.operation);
+	yulAssert(m_assembly.stackHeight() == expectedHeight, "Invalid stack height after operation.");
+
+	m_stack.resize(m_stack.size() - _operation.input.size());
+	for (StackSlot const& slot: _operation.output)
+		m_stack.emplace_back(isLive(slot) ? slot : JunkSlot{});
+}
+
+CFG::BasicBlock const* OptimizedEVMCodeTransform::generateExit(CFG::BasicBlock const& _block)
+{
+	return std::visit(GenericVisitor{
+		[&](CFG::BasicBlock::MainExit const&) -> CFG::BasicBlock const* {
+			// Stop unless this is the end of the generated code.
+			if (!m_graph.functions.empty() || !m_stagedBlocks.empty())
+				m_assembly.appendInstruction(evmasm::Instruction::STOP);
+			return nullptr;
+		},
+		[&](CFG::BasicBlock::Jump const& _jump) -> CFG::BasicBlock const* {
+			BlockInfo& target = m_blockInfo[_jump.target];
+			if (!target.entryLayout)
+				target.entryLayout = filterLive(m_stack, m_liveIn.at(_jump.target));
+			createStackLayout(*target.entryLayout);
+			if (!target.generated)
+				return _jump.target;
+			m_assembly.appendJumpTo(blockLabel(*_jump.target));
+			return nullptr;
+		},
+		[&](CFG::BasicBlock::ConditionalJump const& _jump) -> CFG::BasicBlock const* {
+			// Like CodeTransform, negate the condition and fall through into the non-zero branch,
+			// unless that branch terminates right away and can be placed out of line.
+			bool const negate =
+				!m_blockInfo[_jump.nonZero].generated &&
+				!holds_alternative<CFG::BasicBlock::Terminated>(_jump.nonZero->exit);
+			CFG::BasicBlock const* jumpTarget = negate ? _jump.zero : _jump.nonZero;
+			CFG::BasicBlock const* fallthroughTarget = negate ? _jump.nonZero : _jump.zero;
+			BlockInfo& jumpInfo = m_blockInfo[jumpTarget];
+			BlockInfo& fallthroughInfo = m_blockInfo[fallthroughTarget];
+
+			Stack layout;
+			if (jumpInfo.entryLayout)
+				layout = *jumpInfo.entryLayout;
+			else if (fallthroughInfo.entryLayout)
+			{
+				// Values needed in the other branch are removed after the jump.
+				layout = *fallthroughInfo.entryLayout;
+				for (StackSlot const& slot: filterLive(m_stack, m_liveIn.at(jumpTarget)))
+					if (find(layout.begin(), layout.end(), slot) == layout.end())
+						layout.emplace_back(slot);
+			}
+			else
+				layout = filterLive(m_stack, m_liveIn.at(_jump.nonZero) + m_liveIn.at(_jump.zero));
+
+			Stack target = layout;
+			target.emplace_back(_jump.condition);
+			createStackLayout(target);
+			if (negate)
+				m_assembly.appendInstruction(evmasm::Instruction::ISZERO);
+			m_assembly.appendJumpToIf(blockLabel(*jumpTarget));
+			m_stack.pop_back();
+
+			// Values only needed in one of the branches are junk in the other one.
+			if (!jumpInfo.entryLayout)
+				jumpInfo.entryLayout = junkUnlessLive(layout, m_liveIn.at(jumpTarget));
+			if (!jumpInfo.generated)
+				m_stagedBlocks.emplace_back(jumpTarget);
+
+			if (!fallthroughInfo.entryLayout)
+				fallthroughInfo.entryLayout = junkUnlessLive(m_stack, m_liveIn.at(fallthroughTarget));
+			createStackLayout(*fallthroughInfo.entryLayout);
+			if (!fallthroughInfo.generated)
+				return fallthroughTarget;
+			m_assembly.appendJumpTo(blockLabel(*fallthroughTarget));
+			return nullptr;
+		},
+		[&](CFG::BasicBlock::FunctionReturn const& _return) -> CFG::BasicBlock const* {
+			// The return values are below the return label, the first one is deepest.
+			Stack target(_return.info->returnVariables.begin(), _return.info->returnVariables.end());
+			target.emplace_back(FunctionReturnLabelSlot{});
+			createStackLayout(target);
+			m_assembly.appendJump(0, AbstractAssembly::JumpType::OutOfFunction);
+			return nullptr;
+		},
+		[&](CFG::BasicBlock::Terminated const&) -> CFG::BasicBlock const* { return nullptr; }
+	}, _block.exit);
+}
+
+void OptimizedEVMCodeTransform::createStackLayout(Stack const& _target)
+{
+	auto checkDepth = [&](size_t _depth) {
+		if (_depth > 16)
+			BOOST_THROW_EXCEPTION(StackTooDeepError(
+				m_currentFunction ? m_currentFunction->definition->name : YulString{},
+				YulString{},
+				static_cast<int>(_depth) - 16
+			));
+	};
+	shuffleStack(
+		m_stack,
+		_target,
+		[&](size_t _depth) {
+			checkDepth(_depth);
+			m_assembly.appendInstruction(evmasm::swapInstruction(static_cast<unsigned>(_depth)));
+		},
+		[&](size_t _depth) {
+			checkDepth(_depth);
+			m_assembly.appendInstruction(evmasm::dupInstruction(static_cast<unsigned>(_depth)));
+		},
+		[&](StackSlot const& _slot) {
+			std::visit(GenericVisitor{
+				[&](LiteralSlot const& _literal) { m_assembly.appendConstant(_literal.value); },
+				[&](FunctionCallReturnLabelSlot const& _label) {
+					m_assembly.appendLabelReference(returnLabel(*_label.call));
+				},
+				[&](JunkSlot const&) { m_assembly.appendConstant(0); },
+				[&](auto const&) { yulAssert(false, "Slot cannot be pushed."); }
+			}, _slot);
+		},
+		[&]() { m_assembly.appendInstruction(evmasm::Instruction::POP); }
+	);
+	// The values in junk slots are arbitrary.
+	m_stack = _target;
+	yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()), "");
+}
+
+AbstractAssembly::LabelID OptimizedEVMCodeTransform::blockLabel(CFG::BasicBlock const& _block)
+{
+	BlockInfo& info = m_blockInfo[&_block];
+	if (!info.label)
+		info.label = m_assembly.newLabelId();
+	return *info.label;
+}
+
+AbstractAssembly::LabelID OptimizedEVMCodeTransform::functionLabel(Scope::Function const& _function)
+{
+	if (!m_functionLabels.count(&_function))
+		m_functionLabels[&_function] =
+			m_useNamedLabelsForFunctions ?
+			m_assembly.namedLabel(m_graph.functionInfo.at(&_function).definition->name.str()) :
+			m_assembly.newLabelId();
+	return m_functionLabels.at(&_function);
+}
+
+AbstractAssembly::LabelID OptimizedEVMCodeTransform::returnLabel(FunctionCall const& _call)
+{
+	if (!m_returnLabels.count(&_call))
+		m_returnLabels[&_call] = m_assembly.newLabelId();
+	return m_returnLabels.at(&_call);
+}
@@ -0,0 +1,112 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Code generator for translating Yul to EVM that chooses stack layouts based on liveness.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/AbstractAssembly.h>
+#include <libyul/backends/evm/ControlFlowGraph.h>
+
+#include <list>
+#include <map>
+#include <optional>
+#include <set>
+
+namespace solidity::yul
+{
+struct AsmAnalysisInfo;
+struct BuiltinContext;
+struct EVMDialect;
+
+/**
+ * Alternative to CodeTransform that does not assign fixed stack slots to variables.
+ *
+ * The code is first transformed into a control flow graph (see CFG). Using the variables
+ * that are live at each point, the stack layout before every operation is chosen
+ * to consist of the live values that are already on the stack, in their current order,
+ * followed by the arguments of the operation. Values that are no longer needed are removed
+ * lazily, once they come to the top of the stack or are in the way. The layout at the entry
+ * of a basic block is fixed by the first jump to it that is generated.
+ *
+ * Only supports EVM 1.0 and code without external identifiers.
+ * Throws StackTooDeepError if a stack slot cannot be reached.
+ */
+class OptimizedEVMCodeTransform
+{
+public:
+	static void run(
+		AbstractAssembly& _assembly,
+		AsmAnalysisInfo const& _analysisInfo,
+		Block const& _block,
+		EVMDialect const& _dialect,
+		BuiltinContext& _builtinContext,
+		bool _useNamedLabelsForFunctions = false
+	);
+
+private:
+	OptimizedEVMCodeTransform(
+		AbstractAssembly& _assembly,
+		BuiltinContext& _builtinContext,
+		CFG const& _graph,
+		bool _useNamedLabelsForFunctions
+	);
+
+	/// Computes the slots that are live at the entry of each basic block.
+	void computeLiveness();
+	/// @returns the slots that have to be kept on the stack when leaving @a _block.
+	std::set<StackSlot> requiredAtExit(CFG::BasicBlock const& _block) const;
+
+	/// Generates the code of all blocks reachable from @a _entry, which starts with @a _layout.
+	void generate(CFG::BasicBlock const& _entry, Stack _layout, bool _needsLabel);
+	/// Generates @a _block and the blocks it falls through to.
+	void generateBlocks(CFG::BasicBlock const& _block, bool _needsLabel);
+	void operator()(CFG::Operation const& _operation, std::set<StackSlot> const& _liveAfter);
+	/// Generates the exit of @a _block. @returns the block that is generated next, if any.
+	CFG::BasicBlock const* generateExit(CFG::BasicBlock const& _block);
+
+	/// Shuffles the current stack into @a _target. Junk slots in the target can hold any value.
+	void createStackLayout(Stack const& _target);
+
+	AbstractAssembly::LabelID blockLabel(CFG::BasicBlock const& _block);
+	AbstractAssembly::LabelID functionLabel(Scope::Function const& _function);
+	AbstractAssembly::LabelID returnLabel(FunctionCall const& _call);
+
+	AbstractAssembly& m_assembly;
+	BuiltinContext& m_builtinContext;
+	CFG const& m_graph;
+	bool const m_useNamedLabelsForFunctions = false;
+
+	struct BlockInfo
+	{
+		std::optional<AbstractAssembly::LabelID> label;
+		std::optional<Stack> entryLayout;
+		bool generated = false;
+	};
+	std::map<CFG::BasicBlock const*, BlockInfo> m_blockInfo;
+	std::map<CFG::BasicBlock const*, std::set<StackSlot>> m_liveIn;
+	std::map<Scope::Function const*, AbstractAssembly::LabelID> m_functionLabels;
+	std::map<FunctionCall const*, AbstractAssembly::LabelID> m_returnLabels;
+	/// Blocks that are jumped to but have not been generated yet.
+	std::list<CFG::BasicBlock const*> m_stagedBlocks;
+	CFG::FunctionInfo const* m_currentFunction = nullptr;
+	Stack m_stack;
+};
+
+}
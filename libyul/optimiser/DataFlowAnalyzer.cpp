@@ -147,11 +147,13 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	map<YulString, AssignedValue> value;
 	size_t loopDepth{0};
 	InvertibleRelation<YulString> references;
+	set<YulString> hashValues;
 	InvertibleMap<YulString, YulString> storage;
 	InvertibleMap<YulString, YulString> memory;
 	swap(m_value, value);
 	swap(m_loopDepth, loopDepth);
 	swap(m_references, references);
+	swap(m_hashValues, hashValues);
 	swap(m_storage, storage);
 	swap(m_memory, memory);
 	pushScope(true);
@@ -173,6 +175,7 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	swap(m_value, value);
 	swap(m_loopDepth, loopDepth);
 	swap(m_references, references);
+	swap(m_hashValues, hashValues);
 	swap(m_storage, storage);
 	swap(m_memory, memory);
 }
@@ -238,6 +241,8 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 		// to the variable that will be assigned to.
 		if (movableChecker.movable() && !movableChecker.referencedVariables().count(name))
 			assignValue(name, _value);
+		if (KnowledgeBase::isHash(m_dialect, *_value))
+			m_hashValues.insert(name);
 	}
 
 	auto const& referencedVariables = movableChecker.referencedVariables();
@@ -319,6 +324,8 @@ void DataFlowAnalyzer::clearValues(set<YulString> _variables)
 	// Clear the value and update the reference relation.
 	for (auto const& name: _variables)
 		m_value.erase(name);
+	for (auto const& name: _variables)
+		m_hashValues.erase(name);
 	for (auto const& name: _variables)
 		m_references.eraseKey(name);
 }
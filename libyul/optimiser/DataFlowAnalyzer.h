@@ -92,7 +92,7 @@ public:
 	):
 		m_dialect(_dialect),
 		m_functionSideEffects(std::move(_functionSideEffects)),
-		m_knowledgeBase(_dialect, m_value)
+		m_knowledgeBase(_dialect, m_value, m_hashValues)
 	{}
 
 	using ASTModifier::operator();
@@ -167,6 +167,8 @@ protected:
 	/// m_references.forward[a].contains(b) <=> the current expression assigned to a references b
 	/// m_references.backward[b].contains(a) <=> the current expression assigned to a references b
 	InvertibleRelation<YulString> m_references;
+	/// Variables that currently hold the result of a keccak256 call.
+	std::set<YulString> m_hashValues;
 
 	InvertibleMap<YulString, YulString> m_storage;
 	InvertibleMap<YulString, YulString> m_memory;
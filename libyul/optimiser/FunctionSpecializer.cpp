@@ -0,0 +1,212 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/FunctionSpecializer.h>
+
+#include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/AsmData.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <algorithm>
+#include <functional>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+class CallCollector: public ASTWalker
+{
+public:
+	explicit CallCollector(function<void(FunctionCall const&)> _callback): m_callback(move(_callback)) {}
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _functionCall) override
+	{
+		ASTWalker::operator()(_functionCall);
+		m_callback(_functionCall);
+	}
+
+private:
+	function<void(FunctionCall const&)> m_callback;
+};
+
+}
+
+void FunctionSpecializer::run(OptimiserStepContext& _context, Block& _ast)
+{
+	size_t const budget = CodeSize::codeSizeIncludingFunctions(_ast) * MaxCodeSizeIncreasePercent / 100;
+	FunctionSpecializer specializer{_context, _ast};
+	vector<Statement> copies = specializer.specialize(budget);
+	if (copies.empty())
+		return;
+	_ast.statements += move(copies);
+	specializer(_ast);
+}
+
+void FunctionSpecializer::operator()(FunctionCall& _functionCall)
+{
+	ASTModifier::operator()(_functionCall);
+
+	optional<ArgumentPattern> pattern = argumentPattern(_functionCall);
+	if (!pattern || !m_specializations.count(_functionCall.functionName.name))
+		return;
+	auto const& specializations = m_specializations.at(_functionCall.functionName.name);
+	auto it = specializations.find(*pattern);
+	if (it == specializations.end())
+		return;
+
+	vector<Expression> arguments;
+	for (size_t i = 0; i < _functionCall.arguments.size(); ++i)
+		if (!(*pattern)[i])
+			arguments.emplace_back(move(_functionCall.arguments[i]));
+	_functionCall.functionName.name = it->second;
+	_functionCall.arguments = move(arguments);
+}
+
+FunctionSpecializer::FunctionSpecializer(OptimiserStepContext& _context, Block const& _ast):
+	m_context(_context)
+{
+	for (auto const& statement: _ast.statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+		{
+			map<YulString, size_t> references = ReferencesCounter::countReferences(function->body);
+			m_functions[function->name] = function;
+			m_usedParameters[function->name] = applyMap(function->parameters, [&](TypedName const& _parameter) {
+				return references.count(_parameter.name) > 0;
+			});
+		}
+
+	CallCollector{[&](FunctionCall const& _functionCall) {
+		optional<ArgumentPattern> pattern = argumentPattern(_functionCall);
+		if (!pattern)
+			return;
+		auto& [count, constants] = m_patterns[_functionCall.functionName.name][*pattern];
+		if (count++ == 0)
+			for (size_t i = 0; i < _functionCall.arguments.size(); ++i)
+				constants.emplace_back(
+					(*pattern)[i] ? optional<Literal>{get<Literal>(_functionCall.arguments[i])} : nullopt
+				);
+	}}(_ast);
+}
+
+optional<FunctionSpecializer::ArgumentPattern> FunctionSpecializer::argumentPattern(
+	FunctionCall const& _functionCall
+) const
+{
+	if (!m_usedParameters.count(_functionCall.functionName.name))
+		return nullopt;
+	vector<bool> const& used = m_usedParameters.at(_functionCall.functionName.name);
+	yulAssert(used.size() == _functionCall.arguments.size(), "");
+
+	ArgumentPattern pattern;
+	bool hasConstant = false;
+	for (size_t i = 0; i < _functionCall.arguments.size(); ++i)
+	{
+		Literal const* literal = get_if<Literal>(&_functionCall.arguments[i]);
+		if (used[i] && literal && (literal->kind == LiteralKind::Number || literal->kind == LiteralKind::Boolean))
+		{
+			pattern.emplace_back(make_pair(valueOfLiteral(*literal), literal->type));
+			hasConstant = true;
+		}
+		else
+			pattern.emplace_back(nullopt);
+	}
+	if (!hasConstant)
+		return nullopt;
+	return pattern;
+}
+
+vector<Statement> FunctionSpecializer::specialize(size_t _budget)
+{
+	struct Candidate
+	{
+		YulString function;
+		ArgumentPattern const* pattern;
+		size_t callSites;
+	};
+	vector<Candidate> candidates;
+	for (auto const& [function, patterns]: m_patterns)
+		for (auto const& [pattern, info]: patterns)
+			// A pattern with a single call site is better handled by the FullInliner.
+			if (info.first > 1)
+				candidates.emplace_back(Candidate{function, &pattern, info.first});
+	stable_sort(candidates.begin(), candidates.end(), [](Candidate const& _a, Candidate const& _b) {
+		return _a.callSites > _b.callSites;
+	});
+
+	vector<Statement> copies;
+	for (Candidate const& candidate: candidates)
+	{
+		FunctionDefinition const& function = *m_functions.at(candidate.function);
+		size_t const size = CodeSize::codeSize(function.body);
+		if (size > _budget)
+			continue;
+		_budget -= size;
+
+		YulString newName = m_context.dispenser.newName(function.name);
+		m_specializations[function.name][*candidate.pattern] = newName;
+		copies.emplace_back(createCopy(
+			function,
+			newName,
+			m_patterns.at(candidate.function).at(*candidate.pattern).second
+		));
+	}
+	return copies;
+}
+
+FunctionDefinition FunctionSpecializer::createCopy(
+	FunctionDefinition const& _function,
+	YulString _newName,
+	vector<optional<Literal>> const& _constants
+)
+{
+	map<YulString, YulString> replacements;
+	auto renamed = [&](TypedName const& _variable) {
+		YulString newName = m_context.dispenser.newName(_variable.name);
+		replacements[_variable.name] = newName;
+		return TypedName{_variable.location, newName, _variable.type};
+	};
+
+	FunctionDefinition copy{_function.location, _newName, {}, {}, {}};
+	vector<Statement> constantDeclarations;
+	for (size_t i = 0; i < _function.parameters.size(); ++i)
+		if (_constants[i])
+			constantDeclarations.emplace_back(VariableDeclaration{
+				_function.location,
+				{renamed(_function.parameters[i])},
+				make_unique<Expression>(*_constants[i])
+			});
+		else
+			copy.parameters.emplace_back(renamed(_function.parameters[i]));
+	for (TypedName const& returnVariable: _function.returnVariables)
+		copy.returnVariables.emplace_back(renamed(returnVariable));
+
+	Block body = BodyCopier{m_context.dispenser, move(replacements)}.translate(_function.body);
+	copy.body = Block{body.location, move(constantDeclarations)};
+	copy.body.statements += move(body.statements);
+	return copy;
+}
@@ -0,0 +1,106 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser component that creates copies of functions for constant arguments.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/AsmData.h>
+
+#include <libsolutil/Common.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Optimiser component that creates a copy of a function for a combination of constant
+ * arguments that recurs at several call sites. The copy takes only the remaining
+ * arguments and starts by declaring the former parameters as variables initialised
+ * with the constants, so that later steps like the ExpressionSimplifier can fold them.
+ *
+ * Example:
+ *
+ *   function f(a, b) -> r { r := add(mul(a, 2), b) }
+ *   let x := f(3, calldataload(0))
+ *   let y := f(3, calldataload(32))
+ *
+ * is transformed to
+ *
+ *   function f(a, b) -> r { r := add(mul(a, 2), b) }
+ *   let x := f_1(calldataload(0))
+ *   let y := f_1(calldataload(32))
+ *   function f_1(b_3) -> r_4 { let a_2 := 3 r_4 := add(mul(a_2, 2), b_3) }
+ *
+ * Only number and boolean literals are considered and only for parameters that are used
+ * in the function body. Combinations are handled in the order of the number of their call
+ * sites and only as long as the total size of the copies stays within
+ * MaxCodeSizeIncreasePercent of the size of the whole code.
+ *
+ * Prerequisites: Disambiguator, FunctionHoister, LiteralRematerialiser
+ *
+ * The LiteralRematerialiser is not required for correctness, but arguments are only
+ * recognised as constants if they are literals.
+ */
+class FunctionSpecializer: public ASTModifier
+{
+public:
+	static constexpr char const* name{"FunctionSpecializer"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	/// Maximum total size of the created copies, in percent of the code size before the step.
+	static size_t constexpr MaxCodeSizeIncreasePercent = 20;
+
+	using ASTModifier::operator();
+	void operator()(FunctionCall& _functionCall) override;
+
+private:
+	/// Constant value and type of each argument that is a literal passed to a used parameter.
+	using ArgumentPattern = std::vector<std::optional<std::pair<u256, YulString>>>;
+
+	FunctionSpecializer(OptimiserStepContext& _context, Block const& _ast);
+
+	/// @returns the pattern of the arguments of @a _functionCall or nullopt
+	/// if it does not call a user-defined function with a constant argument.
+	std::optional<ArgumentPattern> argumentPattern(FunctionCall const& _functionCall) const;
+	/// Selects the patterns to create copies for within the size budget and creates them.
+	std::vector<Statement> specialize(size_t _budget);
+	FunctionDefinition createCopy(
+		FunctionDefinition const& _function,
+		YulString _newName,
+		std::vector<std::optional<Literal>> const& _constants
+	);
+
+	OptimiserStepContext& m_context;
+	std::map<YulString, FunctionDefinition const*> m_functions;
+	/// Parameters of each function that are referenced in its body.
+	std::map<YulString, std::vector<bool>> m_usedParameters;
+	/// Number of call sites and constant arguments of the first call site for each pattern.
+	std::map<YulString, std::map<ArgumentPattern, std::pair<size_t, std::vector<std::optional<Literal>>>>> m_patterns;
+	/// Name of the copy for each pattern that was selected.
+	std::map<YulString, std::map<ArgumentPattern, YulString>> m_specializations;
+};
+
+}
@@ -26,6 +26,7 @@
 #include <libyul/optimiser/SimplificationRules.h>
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/backends/evm/EVMDialect.h>
 
 #include <libsolutil/CommonData.h>
 
@@ -49,6 +50,14 @@ bool KnowledgeBase::knownToBeDifferent(YulString _a, YulString _b)
 	if (holds_alternative<Literal>(expr2))
 		return valueOfLiteral(std::get<Literal>(expr2)) == 0;
 
+	// A hash value plus a small offset is practically never equal to a small constant.
+	u256 const smallLimit = u256(1) << 64;
+	for (auto [hash, constant]: {make_pair(_a, _b), make_pair(_b, _a)})
+		if (offsetFromHash(hash))
+			if (auto value = valueIfKnownConstant(constant))
+				if (*value < smallLimit)
+					return true;
+
 	return false;
 }
 
@@ -67,6 +76,65 @@ bool KnowledgeBase::knownToBeDifferentByAtLeast32(YulString _a, YulString _b)
 	return false;
 }
 
+bool KnowledgeBase::isHash(Dialect const& _dialect, Expression const& _expression)
+{
+	if (FunctionCall const* funCall = get_if<FunctionCall>(&_expression))
+		if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&_dialect))
+			if (auto const* builtin = dialect->builtin(funCall->functionName.name))
+				return builtin->instruction == evmasm::Instruction::KECCAK256;
+	return false;
+}
+
+optional<u256> KnowledgeBase::valueIfKnownConstant(YulString _variable)
+{
+	// Follow chains of variables that are copies of each other.
+	for (size_t depth = 0; depth < 8; ++depth)
+	{
+		auto it = m_variableValues.find(_variable);
+		if (it == m_variableValues.end() || !it->second.value)
+			return nullopt;
+		if (Literal const* literal = get_if<Literal>(it->second.value))
+			return valueOfLiteral(*literal);
+		Identifier const* identifier = get_if<Identifier>(it->second.value);
+		if (!identifier)
+			return nullopt;
+		_variable = identifier->name;
+	}
+	return nullopt;
+}
+
+optional<u256> KnowledgeBase::offsetFromHash(YulString _variable, size_t _depth)
+{
+	if (m_hashValues.count(_variable))
+		return u256(0);
+
+	auto it = m_variableValues.find(_variable);
+	if (_depth >= 8 || it == m_variableValues.end() || !it->second.value)
+		return nullopt;
+
+	FunctionCall const* funCall = get_if<FunctionCall>(it->second.value);
+	if (!funCall || funCall->functionName.name != "add"_yulstring || funCall->arguments.size() != 2)
+		return nullopt;
+
+	u256 const smallLimit = u256(1) << 64;
+	for (size_t i: {0u, 1u})
+	{
+		Identifier const* base = get_if<Identifier>(&funCall->arguments[i]);
+		Expression const& summand = funCall->arguments[1 - i];
+		optional<u256> summandValue;
+		if (Literal const* literal = get_if<Literal>(&summand))
+			summandValue = valueOfLiteral(*literal);
+		else if (Identifier const* identifier = get_if<Identifier>(&summand))
+			summandValue = valueIfKnownConstant(identifier->name);
+		if (!base || !summandValue || *summandValue >= smallLimit)
+			continue;
+		if (auto offset = offsetFromHash(base->name, _depth + 1))
+			if (*offset + *summandValue < smallLimit)
+				return *offset + *summandValue;
+	}
+	return nullopt;
+}
+
 Expression KnowledgeBase::simplify(Expression _expression)
 {
 	bool startedRecursion = (m_recursionCounter == 0);
@@ -23,7 +23,11 @@
 
 #include <libyul/AsmDataForward.h>
 #include <libyul/YulString.h>
+#include <libsolutil/Common.h>
+
 #include <map>
+#include <optional>
+#include <set>
 
 namespace solidity::yul
 {
@@ -34,25 +38,45 @@ struct AssignedValue;
 /**
  * Class that can answer questions about values of variables and their relations.
  *
- * The reference to the map of values provided at construction is assumed to be updating.
+ * The references to the map of values and the set of hash values provided at construction
+ * are assumed to be updating.
+ *
+ * Variables in the set of hash values hold the result of a keccak256 call. Such values and
+ * small offsets from them are assumed to be different from small constants. This is
+ * what Solidity relies on when it places mappings and dynamic arrays in storage.
  */
 class KnowledgeBase
 {
 public:
-	KnowledgeBase(Dialect const& _dialect, std::map<YulString, AssignedValue> const& _variableValues):
+	KnowledgeBase(
+		Dialect const& _dialect,
+		std::map<YulString, AssignedValue> const& _variableValues,
+		std::set<YulString> const& _hashValues
+	):
 		m_dialect(_dialect),
-		m_variableValues(_variableValues)
+		m_variableValues(_variableValues),
+		m_hashValues(_hashValues)
 	{}
 
 	bool knownToBeDifferent(YulString _a, YulString _b);
 	bool knownToBeDifferentByAtLeast32(YulString _a, YulString _b);
 	bool knownToBeEqual(YulString _a, YulString _b) const { return _a == _b; }
+	/// @returns the value of the variable if it is known to be constant.
+	std::optional<u256> valueIfKnownConstant(YulString _variable);
+
+	/// @returns true if the expression is a call to the keccak256 builtin.
+	static bool isHash(Dialect const& _dialect, Expression const& _expression);
 
 private:
+	/// @returns the offset of the variable from a hash value if it is known to be
+	/// a hash value plus a small constant.
+	std::optional<u256> offsetFromHash(YulString _variable, size_t _depth = 0);
+
 	Expression simplify(Expression _expression);
 
 	Dialect const& m_dialect;
 	std::map<YulString, AssignedValue> const& m_variableValues;
+	std::set<YulString> const& m_hashValues;
 	size_t m_recursionCounter = 0;
 };
 
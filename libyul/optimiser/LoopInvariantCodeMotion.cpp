@@ -19,9 +19,11 @@
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
 
 #include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/DataFlowAnalyzer.h>
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/AsmData.h>
 #include <libsolutil/CommonData.h>
 
@@ -31,13 +33,94 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
+namespace
+{
+
+/**
+ * Collects the slots of all ``sstore(a, v)`` calls where ``a`` is a variable.
+ * The result is not valid if the code can also write to storage in any other way.
+ */
+class StorageWriteCollector: public ASTWalker
+{
+public:
+	StorageWriteCollector(Dialect const& _dialect, map<YulString, SideEffects> const& _functionSideEffects):
+		m_dialect(_dialect),
+		m_functionSideEffects(_functionSideEffects)
+	{}
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _funCall) override
+	{
+		ASTWalker::operator()(_funCall);
+
+		SideEffects sideEffects = SideEffects::worst();
+		if (auto const* builtin = m_dialect.builtin(_funCall.functionName.name))
+		{
+			if (auto const* evmDialect = dynamic_cast<EVMDialect const*>(&m_dialect))
+				if (evmDialect->builtin(_funCall.functionName.name)->instruction == evmasm::Instruction::SSTORE)
+					if (Identifier const* slot = get_if<Identifier>(&_funCall.arguments.at(0)))
+					{
+						m_slots.insert(slot->name);
+						return;
+					}
+			sideEffects = builtin->sideEffects;
+		}
+		else if (m_functionSideEffects.count(_funCall.functionName.name))
+			sideEffects = m_functionSideEffects.at(_funCall.functionName.name);
+
+		if (sideEffects.storage == SideEffects::Write)
+			m_valid = false;
+	}
+
+	optional<set<YulString>> slots() const
+	{
+		if (m_valid)
+			return m_slots;
+		return nullopt;
+	}
+
+private:
+	Dialect const& m_dialect;
+	map<YulString, SideEffects> const& m_functionSideEffects;
+	set<YulString> m_slots;
+	bool m_valid = true;
+};
+
+}
+
 void LoopInvariantCodeMotion::run(OptimiserStepContext& _context, Block& _ast)
 {
 	map<YulString, SideEffects> functionSideEffects =
 		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
 	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
 	set<YulString> ssaVars = SSAValueTracker::ssaVariables(_ast);
-	LoopInvariantCodeMotion{_context.dialect, ssaVars, functionSideEffects, containsMSize}(_ast);
+
+	// The values of SSA variables hold everywhere the variables are in scope,
+	// as long as they only reference other SSA variables.
+	SSAValueTracker ssaValueTracker;
+	ssaValueTracker(_ast);
+	map<YulString, AssignedValue> ssaValues;
+	set<YulString> hashValues;
+	for (auto const& [name, value]: ssaValueTracker.values())
+	{
+		if (!ssaVars.count(name))
+			continue;
+		if (KnowledgeBase::isHash(_context.dialect, *value))
+			hashValues.insert(name);
+		else
+		{
+			MovableChecker checker{_context.dialect, *value};
+			if (checker.movable() && all_of(
+				checker.referencedVariables().begin(),
+				checker.referencedVariables().end(),
+				[&](YulString _var) { return ssaVars.count(_var); }
+			))
+				ssaValues[name] = {value, 0};
+		}
+	}
+	KnowledgeBase knowledgeBase{_context.dialect, ssaValues, hashValues};
+
+	LoopInvariantCodeMotion{_context.dialect, ssaVars, functionSideEffects, containsMSize, knowledgeBase}(_ast);
 }
 
 void LoopInvariantCodeMotion::operator()(Block& _block)
@@ -58,13 +141,14 @@ void LoopInvariantCodeMotion::operator()(Block& _block)
 bool LoopInvariantCodeMotion::canBePromoted(
 	VariableDeclaration const& _varDecl,
 	set<YulString> const& _varsDefinedInCurrentScope,
-	SideEffects const& _forLoopSideEffects
+	SideEffects const& _forLoopSideEffects,
+	optional<set<YulString>> const& _storageWrites
 ) const
 {
 	// A declaration can be promoted iff
 	// 1. Its LHS is a SSA variable
 	// 2. Its RHS only references SSA variables declared outside of the current scope
-	// 3. Its RHS is movable
+	// 3. Its RHS is movable, or it is a storage load that is not aliased by any write in the loop
 
 	for (auto const& var: _varDecl.variables)
 		if (!m_ssaVariables.count(var.name))
@@ -75,18 +159,51 @@ bool LoopInvariantCodeMotion::canBePromoted(
 			if (_varsDefinedInCurrentScope.count(ref.first) || !m_ssaVariables.count(ref.first))
 				return false;
 		SideEffectsCollector sideEffects{m_dialect, *_varDecl.value, &m_functionSideEffects};
-		if (!sideEffects.movableRelativeTo(_forLoopSideEffects, m_containsMSize))
+		if (
+			!sideEffects.movableRelativeTo(_forLoopSideEffects, m_containsMSize) &&
+			!isUnaliasedStorageLoad(*_varDecl.value, _storageWrites)
+		)
 			return false;
 	}
 	return true;
 }
 
+bool LoopInvariantCodeMotion::isUnaliasedStorageLoad(
+	Expression const& _expression,
+	optional<set<YulString>> const& _storageWrites
+) const
+{
+	if (!_storageWrites)
+		return false;
+	FunctionCall const* funCall = get_if<FunctionCall>(&_expression);
+	auto const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect);
+	if (!funCall || !dialect)
+		return false;
+	auto const* builtin = dialect->builtin(funCall->functionName.name);
+	if (!builtin || builtin->instruction != evmasm::Instruction::SLOAD)
+		return false;
+	Identifier const* slot = get_if<Identifier>(&funCall->arguments.at(0));
+	if (!slot)
+		return false;
+	for (YulString const& writtenSlot: *_storageWrites)
+		if (!m_knowledgeBase.knownToBeDifferent(writtenSlot, slot->name))
+			return false;
+	return true;
+}
+
 optional<vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
 {
 	assertThrow(_for.pre.statements.empty(), OptimizerException, "");
 
 	auto forLoopSideEffects =
 		SideEffectsCollector{m_dialect, _for, &m_functionSideEffects}.sideEffects();
+	optional<set<YulString>> storageWrites;
+	if (forLoopSideEffects.storage == SideEffects::Write)
+	{
+		StorageWriteCollector collector{m_dialect, m_functionSideEffects};
+		collector(_for);
+		storageWrites = collector.slots();
+	}
 
 	vector<Statement> replacement;
 	for (Block* block: {&_for.post, &_for.body})
@@ -99,7 +216,7 @@ optional<vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
 				if (holds_alternative<VariableDeclaration>(_s))
 				{
 					VariableDeclaration const& varDecl = std::get<VariableDeclaration>(_s);
-					if (canBePromoted(varDecl, varsDefinedInScope, forLoopSideEffects))
+					if (canBePromoted(varDecl, varsDefinedInScope, forLoopSideEffects, storageWrites))
 					{
 						replacement.emplace_back(std::move(_s));
 						// Do not add the variables declared here to varsDefinedInScope because we are moving them.
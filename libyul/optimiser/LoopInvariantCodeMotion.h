@@ -20,6 +20,7 @@
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/KnowledgeBase.h>
 
 namespace solidity::yul
 {
@@ -50,19 +51,29 @@ private:
 		Dialect const& _dialect,
 		std::set<YulString> const& _ssaVariables,
 		std::map<YulString, SideEffects> const& _functionSideEffects,
-		bool _containsMSize
+		bool _containsMSize,
+		KnowledgeBase& _knowledgeBase
 	):
 		m_containsMSize(_containsMSize),
 		m_dialect(_dialect),
 		m_ssaVariables(_ssaVariables),
-		m_functionSideEffects(_functionSideEffects)
+		m_functionSideEffects(_functionSideEffects),
+		m_knowledgeBase(_knowledgeBase)
 	{ }
 
 	/// @returns true if the given variable declaration can be moved to in front of the loop.
+	/// @param _storageWrites the slots the loop writes to, if these are all known.
 	bool canBePromoted(
 		VariableDeclaration const& _varDecl,
 		std::set<YulString> const& _varsDefinedInCurrentScope,
-		SideEffects const& _forLoopSideEffects
+		SideEffects const& _forLoopSideEffects,
+		std::optional<std::set<YulString>> const& _storageWrites
+	) const;
+	/// @returns true if the expression is ``sload(k)`` and ``k`` is known to be different
+	/// from all the slots in @a _storageWrites.
+	bool isUnaliasedStorageLoad(
+		Expression const& _expression,
+		std::optional<std::set<YulString>> const& _storageWrites
 	) const;
 	std::optional<std::vector<Statement>> rewriteLoop(ForLoop& _for);
 
@@ -70,6 +81,8 @@ private:
 	Dialect const& m_dialect;
 	std::set<YulString> const& m_ssaVariables;
 	std::map<YulString, SideEffects> const& m_functionSideEffects;
+	/// Knowledge about the values of SSA variables.
+	KnowledgeBase& m_knowledgeBase;
 };
 
 }
@@ -0,0 +1,254 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that unrolls for loops with a small constant number of iterations.
+ */
+
+#include <libyul/optimiser/LoopUnroller.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/AsmData.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Checks if a loop body contains ``break`` or ``continue`` statements that refer to the loop
+/// itself or function definitions, which cannot be copied.
+class LoopExitFinder: public ASTWalker
+{
+public:
+	static bool containsLoopExitOrFunction(vector<Statement> const& _statements, size_t _begin)
+	{
+		LoopExitFinder finder;
+		for (size_t i = _begin; i < _statements.size(); ++i)
+			finder.visit(_statements[i]);
+		return finder.m_found;
+	}
+
+	using ASTWalker::operator();
+	void operator()(Break const&) override { m_found = true; }
+	void operator()(Continue const&) override { m_found = true; }
+	void operator()(FunctionDefinition const&) override { m_found = true; }
+	// Statements in nested loops refer to the nested loop.
+	void operator()(ForLoop const&) override {}
+
+private:
+	bool m_found = false;
+};
+
+}
+
+void LoopUnroller::run(OptimiserStepContext& _context, Block& _ast)
+{
+	LoopUnroller{_context}(_ast);
+}
+
+void LoopUnroller::operator()(Block& _block)
+{
+	DataFlowAnalyzer::operator()(_block);
+
+	iterateReplacing(_block.statements, [&](Statement& _statement) -> optional<vector<Statement>> {
+		auto replacement = m_replacements.find(&_statement);
+		if (replacement == m_replacements.end())
+			return nullopt;
+		vector<Statement> statements = move(replacement->second);
+		m_replacements.erase(replacement);
+		return statements;
+	});
+}
+
+void LoopUnroller::visit(Statement& _statement)
+{
+	// The knowledge of the data flow analyzer refers to the state before the loop,
+	// so the number of iterations is determined before visiting it. Loops nested in the
+	// body are unrolled while visiting, before the copies of the body are created.
+	ForLoop const* loop = get_if<ForLoop>(&_statement);
+	optional<size_t> iterations = loop ? iterationCount(*loop) : nullopt;
+
+	DataFlowAnalyzer::visit(_statement);
+
+	if (!iterations)
+		return;
+	If const* guard = conditionInBody(*loop);
+	size_t const iterationSize =
+		CodeSize::codeSize(loop->body) -
+		(guard ? CodeSize::codeSize(loop->body.statements.front()) : 0) +
+		CodeSize::codeSize(loop->post);
+	if (*iterations * iterationSize <= MaxUnrolledSize)
+		m_replacements[&_statement] = unrolledIterations(*loop, *iterations, true);
+	else
+		for (size_t factor = MaxUnrollFactor; factor > 1; --factor)
+			if (*iterations % factor == 0 && factor * iterationSize <= MaxUnrolledSize)
+			{
+				vector<Statement> body;
+				if (guard)
+					body.emplace_back(ASTCopier{}.translate(loop->body.statements.front()));
+				body += unrolledIterations(*loop, factor, false);
+				ForLoop unrolledLoop{
+					loop->location,
+					Block{loop->pre.location, {}},
+					make_unique<Expression>(ASTCopier{}.translate(*loop->condition)),
+					ASTCopier{}.translate(loop->post),
+					Block{loop->body.location, move(body)}
+				};
+				m_replacements[&_statement] = make_vector<Statement>(move(unrolledLoop));
+				break;
+			}
+}
+
+If const* LoopUnroller::conditionInBody(ForLoop const& _loop) const
+{
+	Literal const* condition = get_if<Literal>(_loop.condition.get());
+	if (!condition || valueOfLiteral(*condition) == 0 || _loop.body.statements.empty())
+		return nullptr;
+	If const* guard = get_if<If>(&_loop.body.statements.front());
+	if (
+		!guard ||
+		guard->body.statements.size() != 1 ||
+		!holds_alternative<Break>(guard->body.statements.front())
+	)
+		return nullptr;
+	FunctionCall const* negation = get_if<FunctionCall>(guard->condition.get());
+	if (
+		!negation ||
+		!m_dialect.booleanNegationFunction() ||
+		negation->functionName.name != m_dialect.booleanNegationFunction()->name
+	)
+		return nullptr;
+	return guard;
+}
+
+optional<size_t> LoopUnroller::iterationCount(ForLoop const& _loop)
+{
+	auto const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect);
+	if (!dialect || !_loop.pre.statements.empty() || _loop.post.statements.empty())
+		return nullopt;
+
+	auto instruction = [&](Expression const& _expression) -> optional<evmasm::Instruction> {
+		FunctionCall const* functionCall = get_if<FunctionCall>(&_expression);
+		if (!functionCall || functionCall->arguments.size() != 2)
+			return nullopt;
+		BuiltinFunctionForEVM const* builtin = dialect->builtin(functionCall->functionName.name);
+		if (!builtin)
+			return nullopt;
+		return builtin->instruction;
+	};
+
+	// Condition: lt(i, n) or gt(n, i), possibly moved into the body by the ForLoopConditionIntoBody
+	If const* guard = conditionInBody(_loop);
+	Expression const& condition = guard ?
+		std::get<FunctionCall>(*guard->condition).arguments.front() :
+		*_loop.condition;
+	optional<evmasm::Instruction> comparison = instruction(condition);
+	if (!comparison || (*comparison != evmasm::Instruction::LT && *comparison != evmasm::Instruction::GT))
+		return nullopt;
+	vector<Expression> const& operands = std::get<FunctionCall>(condition).arguments;
+	Expression const& counterOperand = operands.at(*comparison == evmasm::Instruction::LT ? 0 : 1);
+	Expression const& limit = operands.at(*comparison == evmasm::Instruction::LT ? 1 : 0);
+	if (!holds_alternative<Identifier>(counterOperand))
+		return nullopt;
+	YulString counter = std::get<Identifier>(counterOperand).name;
+
+	// Post block ending in i := add(i, s) or i := add(s, i)
+	Assignment const* increment = get_if<Assignment>(&_loop.post.statements.back());
+	if (
+		!increment ||
+		increment->variableNames.size() != 1 ||
+		increment->variableNames.front().name != counter ||
+		instruction(*increment->value) != evmasm::Instruction::ADD
+	)
+		return nullopt;
+	vector<Expression> const& summands = std::get<FunctionCall>(*increment->value).arguments;
+	Expression const* stepOperand = nullptr;
+	for (size_t i = 0; i < 2; ++i)
+		if (Identifier const* identifier = get_if<Identifier>(&summands[i]); identifier && identifier->name == counter)
+			stepOperand = &summands[1 - i];
+	optional<u256> step = stepOperand ? knownValue(*stepOperand) : nullopt;
+	if (!step || *step == 0)
+		return nullopt;
+
+	optional<u256> start = m_knowledgeBase.valueIfKnownConstant(counter);
+	optional<u256> end = knownValue(limit);
+	if (!start || !end)
+		return nullopt;
+
+	size_t const bodyBegin = guard ? 1 : 0;
+	Assignments assignments;
+	for (size_t i = bodyBegin; i < _loop.body.statements.size(); ++i)
+		assignments.visit(_loop.body.statements[i]);
+	for (size_t i = 0; i + 1 < _loop.post.statements.size(); ++i)
+		assignments.visit(_loop.post.statements[i]);
+	auto assignedInBody = [&](Expression const& _expression) {
+		Identifier const* identifier = get_if<Identifier>(&_expression);
+		return identifier && assignments.names().count(identifier->name);
+	};
+	if (
+		assignments.names().count(counter) ||
+		assignedInBody(limit) ||
+		assignedInBody(*stepOperand) ||
+		LoopExitFinder::containsLoopExitOrFunction(_loop.body.statements, bodyBegin)
+	)
+		return nullopt;
+
+	if (*start >= *end)
+		return 0;
+	bigint iterations = (bigint(*end) - *start + *step - 1) / *step;
+	// The counter must not overflow after the last iteration.
+	if (bigint(*start) + iterations * *step >= (bigint(1) << 256) || iterations > numeric_limits<uint32_t>::max())
+		return nullopt;
+	return static_cast<size_t>(iterations);
+}
+
+optional<u256> LoopUnroller::knownValue(Expression const& _expression)
+{
+	if (Literal const* literal = get_if<Literal>(&_expression))
+		return valueOfLiteral(*literal);
+	else if (Identifier const* identifier = get_if<Identifier>(&_expression))
+		return m_knowledgeBase.valueIfKnownConstant(identifier->name);
+	return nullopt;
+}
+
+vector<Statement> LoopUnroller::unrolledIterations(ForLoop const& _loop, size_t _iterations, bool _withLastPost)
+{
+	size_t const bodyBegin = conditionInBody(_loop) ? 1 : 0;
+	vector<Statement> statements;
+	for (size_t i = 0; i < _iterations; ++i)
+	{
+		BodyCopier copier{m_nameDispenser, {}};
+		Block body{_loop.body.location, {}};
+		for (size_t j = bodyBegin; j < _loop.body.statements.size(); ++j)
+			body.statements.emplace_back(copier.translate(_loop.body.statements[j]));
+		statements.emplace_back(move(body));
+		if (_withLastPost || i + 1 < _iterations)
+			statements.emplace_back(BodyCopier{m_nameDispenser, {}}.translate(_loop.post));
+	}
+	return statements;
+}
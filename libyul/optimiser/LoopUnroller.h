@@ -0,0 +1,106 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that unrolls for loops with a small constant number of iterations.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Optimisation stage that unrolls for loops whose number of iterations is known.
+ *
+ * A loop is considered if it has the form
+ *
+ *   for { } lt(i, n) { ... i := add(i, s) } { body }
+ *
+ * or uses ``gt(n, i)`` or has its condition moved into the body by the ForLoopConditionIntoBody:
+ *
+ *   for { } 1 { ... i := add(i, s) } { if iszero(lt(i, n)) { break } body }
+ *
+ * Here, ``n`` and ``s`` have to be known constants, the value of ``i`` has to be known before
+ * the loop, ``i``, ``n`` and ``s`` must not be assigned anywhere else in the loop and the body
+ * must not contain ``break`` or ``continue`` for this loop.
+ *
+ * If the unrolled code is small enough, the loop is replaced by one copy of the body and
+ * the post block for each iteration:
+ *
+ *   { body } { i := add(i, s) } { body } { i := add(i, s) } ...
+ *
+ * Otherwise, the body of the loop is replaced by several iterations if their number
+ * divides the number of iterations of the loop, so that the condition is checked
+ * less often:
+ *
+ *   for { } lt(i, n) { i := add(i, s) } { { body } { i := add(i, s) } { body } }
+ *
+ * The size of the unrolled code is limited by MaxUnrolledSize. The copies of the body
+ * are meant to be simplified further by steps like the ExpressionSimplifier, which can
+ * compute the values of ``i``, after the blocks have been flattened and the code has been
+ * transformed into SSA form.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter, FunctionHoister.
+ */
+class LoopUnroller: public DataFlowAnalyzer
+{
+public:
+	static constexpr char const* name{"LoopUnroller"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	/// Maximum code size of the copies of the body and the post block that replace a loop
+	/// or the body of a loop.
+	static size_t constexpr MaxUnrolledSize = 60;
+	/// Maximum number of copies of the body in a loop that is unrolled partially.
+	static size_t constexpr MaxUnrollFactor = 8;
+
+	using DataFlowAnalyzer::operator();
+	void operator()(Block& _block) override;
+
+protected:
+	void visit(Statement& _statement) override;
+
+private:
+	explicit LoopUnroller(OptimiserStepContext& _context):
+		DataFlowAnalyzer(_context.dialect),
+		m_nameDispenser(_context.dispenser)
+	{}
+
+	/// @returns the statement ``if iszero(c) { break }`` at the start of the body of @a _loop
+	/// if its condition is a non-zero constant, i.e. the condition has been moved into the body.
+	If const* conditionInBody(ForLoop const& _loop) const;
+	/// @returns the number of iterations of @a _loop if it has the form described above.
+	std::optional<size_t> iterationCount(ForLoop const& _loop);
+	std::optional<u256> knownValue(Expression const& _expression);
+	/// @returns @a _iterations copies of the body of @a _loop, each followed by a copy of the
+	/// post block, except for the last one if @a _withLastPost is false.
+	std::vector<Statement> unrolledIterations(ForLoop const& _loop, size_t _iterations, bool _withLastPost);
+
+	NameDispenser& m_nameDispenser;
+	/// Statements that replace for loops, filled while visiting the block that contains them.
+	std::map<Statement const*, std::vector<Statement>> m_replacements;
+};
+
+}
@@ -0,0 +1,527 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that keeps small memory objects that do not escape in variables.
+ */
+
+#include <libyul/optimiser/MemoryScalarReplacer.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/FunctionCallFinder.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/AsmData.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Variables that point into a memory object together with their offsets in bytes.
+struct ObjectPointers
+{
+	EVMDialect const& dialect;
+	function<optional<u256>(Expression const&)> constantValue;
+	size_t words = 0;
+	map<YulString, bigint> offsets;
+
+	optional<evmasm::Instruction> instruction(FunctionCall const& _call) const
+	{
+		if (auto const* builtin = dialect.builtin(_call.functionName.name))
+			return builtin->instruction;
+		return nullopt;
+	}
+	optional<evmasm::Instruction> instruction(Expression const& _expression) const
+	{
+		if (auto const* call = get_if<FunctionCall>(&_expression))
+			return instruction(*call);
+		return nullopt;
+	}
+
+	/// @returns the offset in bytes that @a _expression points to, if it is a pointer
+	/// variable or the sum of a pointer variable and a constant.
+	optional<bigint> offset(Expression const& _expression) const
+	{
+		if (auto const* identifier = get_if<Identifier>(&_expression))
+			if (offsets.count(identifier->name))
+				return offsets.at(identifier->name);
+		if (instruction(_expression) == evmasm::Instruction::ADD)
+		{
+			auto const& arguments = get<FunctionCall>(_expression).arguments;
+			for (size_t i = 0; i < 2; ++i)
+				if (auto const* identifier = get_if<Identifier>(&arguments[i]))
+					if (offsets.count(identifier->name))
+						if (auto value = constantValue(arguments[1 - i]))
+							return offsets.at(identifier->name) + *value;
+		}
+		return nullopt;
+	}
+
+	/// @returns the index of the word that is accessed at @a _address, if it is inside
+	/// the object and aligned.
+	optional<size_t> word(Expression const& _address) const
+	{
+		if (auto value = offset(_address))
+			if (*value % 32 == 0 && *value < bigint(words) * 32)
+				return static_cast<size_t>(*value / 32);
+		return nullopt;
+	}
+
+	/// @returns true if @a _call is ``calldatacopy(p, calldatasize(), size)``, which zeroes
+	/// the whole object.
+	bool isZeroing(FunctionCall const& _call) const
+	{
+		return
+			instruction(_call) == evmasm::Instruction::CALLDATACOPY &&
+			offset(_call.arguments[0]) == bigint(0) &&
+			instruction(_call.arguments[1]) == evmasm::Instruction::CALLDATASIZE &&
+			constantValue(_call.arguments[2]) == u256(words * 32);
+	}
+
+	template <class Node>
+	bool references(Node const& _node) const
+	{
+		ReferencesCounter counter{ReferencesCounter::OnlyVariables};
+		counter.visit(_node);
+		for (auto const& reference: counter.references())
+			if (offsets.count(reference.first))
+				return true;
+		return false;
+	}
+};
+
+/// Checks that pointers into a memory object are only used for accesses at fixed
+/// words and collects variables that are declared as pointers into the object.
+class PointerUseChecker: public ASTWalker
+{
+public:
+	PointerUseChecker(ObjectPointers& _pointers, map<YulString, Expression const*> const& _ssaValues):
+		m_pointers(_pointers), m_ssaValues(_ssaValues)
+	{}
+
+	bool escapes() const { return m_escapes; }
+
+	using ASTWalker::operator();
+	void operator()(Identifier const& _identifier) override
+	{
+		if (m_pointers.offsets.count(_identifier.name))
+			m_escapes = true;
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		if (
+			_varDecl.variables.size() == 1 &&
+			_varDecl.value &&
+			m_ssaValues.count(_varDecl.variables.front().name)
+		)
+			if (auto offset = m_pointers.offset(*_varDecl.value))
+			{
+				m_pointers.offsets[_varDecl.variables.front().name] = *offset;
+				return;
+			}
+		ASTWalker::operator()(_varDecl);
+	}
+	void operator()(FunctionCall const& _call) override
+	{
+		auto instruction = m_pointers.instruction(_call);
+		if (instruction == evmasm::Instruction::MLOAD && m_pointers.word(_call.arguments[0]))
+			return;
+		if (instruction == evmasm::Instruction::MSTORE && m_pointers.word(_call.arguments[0]))
+		{
+			visit(_call.arguments[1]);
+			return;
+		}
+		if (m_pointers.isZeroing(_call))
+			return;
+		ASTWalker::operator()(_call);
+	}
+
+private:
+	ObjectPointers& m_pointers;
+	map<YulString, Expression const*> const& m_ssaValues;
+	bool m_escapes = false;
+};
+
+/// Replaces the accesses to a memory object by accesses to the variables of its words.
+class WordReplacer: public ASTModifier
+{
+public:
+	WordReplacer(ObjectPointers const& _pointers, vector<YulString> const& _words):
+		m_pointers(_pointers), m_words(_words)
+	{}
+
+	using ASTModifier::operator();
+	void visit(Statement& _statement) override
+	{
+		ASTModifier::visit(_statement);
+
+		auto* expressionStatement = get_if<ExpressionStatement>(&_statement);
+		if (!expressionStatement)
+			return;
+		FunctionCall* call = get_if<FunctionCall>(&expressionStatement->expression);
+		if (!call)
+			return;
+		langutil::SourceLocation const location = call->location;
+		if (m_pointers.instruction(*call) == evmasm::Instruction::MSTORE)
+		{
+			if (auto word = m_pointers.word(call->arguments[0]))
+			{
+				auto value = make_unique<Expression>(std::move(call->arguments[1]));
+				_statement = Assignment{location, {Identifier{location, m_words[*word]}}, std::move(value)};
+			}
+		}
+		else if (m_pointers.isZeroing(*call))
+		{
+			Block block{location, {}};
+			for (YulString word: m_words)
+				block.statements.emplace_back(Assignment{
+					location,
+					{Identifier{location, word}},
+					make_unique<Expression>(Literal{location, LiteralKind::Number, "0"_yulstring, {}})
+				});
+			_statement = std::move(block);
+		}
+	}
+	void visit(Expression& _expression) override
+	{
+		if (m_pointers.instruction(_expression) == evmasm::Instruction::MLOAD)
+		{
+			FunctionCall const& call = get<FunctionCall>(_expression);
+			if (auto word = m_pointers.word(call.arguments[0]))
+			{
+				_expression = Identifier{call.location, m_words[*word]};
+				return;
+			}
+		}
+		ASTModifier::visit(_expression);
+	}
+
+private:
+	ObjectPointers const& m_pointers;
+	vector<YulString> const& m_words;
+};
+
+}
+
+void MemoryScalarReplacer::run(OptimiserStepContext& _context, Block& _ast)
+{
+	auto const* evmDialect = dynamic_cast<EVMDialect const*>(&_context.dialect);
+	if (!evmDialect)
+		return;
+	// Without ``memoryguard``, memory can be accessed at arbitrary addresses.
+	if (FunctionCallFinder::run(_ast, "memoryguard"_yulstring).empty())
+		return;
+	if (MSizeFinder::containsMSize(_context.dialect, _ast))
+		return;
+
+	MemoryScalarReplacer{_context, *evmDialect, _ast}(_ast);
+}
+
+MemoryScalarReplacer::MemoryScalarReplacer(
+	OptimiserStepContext& _context,
+	EVMDialect const& _dialect,
+	Block const& _ast
+):
+	m_context(_context),
+	m_dialect(_dialect)
+{
+	SSAValueTracker tracker;
+	tracker(_ast);
+	m_ssaValues = tracker.values();
+
+	for (Statement const& statement: _ast.statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+			if (isAllocationFunction(*function))
+				m_allocationFunctions.insert(function->name);
+}
+
+void MemoryScalarReplacer::operator()(ForLoop& _loop)
+{
+	// Variables declared in the pre block are also visible in the rest of the loop,
+	// so objects allocated there are not considered.
+	ASTModifier::operator()(_loop.pre);
+	visit(*_loop.condition);
+	(*this)(_loop.post);
+	(*this)(_loop.body);
+}
+
+void MemoryScalarReplacer::operator()(Block& _block)
+{
+	for (size_t index = 0; index < _block.statements.size(); ++index)
+	{
+		optional<Allocation> allocation = allocationAt(_block.statements, index);
+		if (!allocation)
+			continue;
+		size_t const begin = index + allocation->statements;
+
+		ObjectPointers pointers{
+			m_dialect,
+			[this](Expression const& _expression) { return constantValue(_expression); },
+			allocation->words,
+			{{allocation->pointer, 0}}
+		};
+		for (YulString copy: allocation->copies)
+			pointers.offsets[copy] = 0;
+		for (YulString end: allocation->ends)
+			pointers.offsets[end] = bigint(allocation->words) * 32;
+
+		PointerUseChecker checker{pointers, m_ssaValues};
+		for (size_t i = begin; i < _block.statements.size(); ++i)
+			checker.visit(_block.statements[i]);
+		if (checker.escapes())
+			continue;
+
+		// All words have to be written before the object is used in any other way.
+		vector<bool> written(allocation->words, false);
+		for (size_t i = begin; i < _block.statements.size(); ++i)
+		{
+			Statement const& statement = _block.statements[i];
+			if (!pointers.references(statement))
+				continue;
+			if (auto const* varDecl = get_if<VariableDeclaration>(&statement))
+				if (varDecl->variables.size() == 1 && pointers.offsets.count(varDecl->variables.front().name))
+					continue;
+			auto const* expressionStatement = get_if<ExpressionStatement>(&statement);
+			if (!expressionStatement)
+				break;
+			auto const& call = get<FunctionCall>(expressionStatement->expression);
+			if (pointers.isZeroing(call))
+				written.assign(written.size(), true);
+			else if (
+				pointers.instruction(call) == evmasm::Instruction::MSTORE &&
+				pointers.word(call.arguments[0]) &&
+				!pointers.references(call.arguments[1])
+			)
+				written[*pointers.word(call.arguments[0])] = true;
+			else
+				break;
+		}
+		if (!all_of(written.begin(), written.end(), [](bool _written) { return _written; }))
+			continue;
+
+		vector<YulString> words;
+		TypedNameList variables;
+		langutil::SourceLocation const location = locationOf(_block.statements[index]);
+		for (size_t i = 0; i < allocation->words; ++i)
+		{
+			words.emplace_back(m_context.dispenser.newName(
+				YulString{allocation->pointer.str() + "_" + to_string(i)}
+			));
+			variables.emplace_back(TypedName{location, words.back(), {}});
+		}
+
+		WordReplacer replacer{pointers, words};
+		for (size_t i = begin; i < _block.statements.size(); ++i)
+			replacer.visit(_block.statements[i]);
+		_block.statements.insert(
+			_block.statements.begin() + static_cast<ptrdiff_t>(begin),
+			VariableDeclaration{location, std::move(variables), {}}
+		);
+		index = begin;
+	}
+
+	ASTModifier::operator()(_block);
+}
+
+optional<MemoryScalarReplacer::Allocation> MemoryScalarReplacer::allocationAt(
+	vector<Statement> const& _statements,
+	size_t _index
+) const
+{
+	auto const* varDecl = get_if<VariableDeclaration>(&_statements[_index]);
+	if (!varDecl || varDecl->variables.size() != 1 || !varDecl->value)
+		return nullopt;
+	Allocation allocation{varDecl->variables.front().name, 0, 1, {}, {}};
+	if (!m_ssaValues.count(allocation.pointer))
+		return nullopt;
+
+	Expression const* size = nullptr;
+	if (
+		auto const* call = get_if<FunctionCall>(varDecl->value.get());
+		call && m_allocationFunctions.count(call->functionName.name)
+	)
+		size = &call->arguments.front();
+	else if (
+		instruction(*varDecl->value) == evmasm::Instruction::MLOAD &&
+		constantValue(get<FunctionCall>(*varDecl->value).arguments.front()) == u256(64)
+	)
+		size = allocationTail(_statements, _index + 1, allocation);
+	if (!size)
+		return nullopt;
+
+	optional<u256> sizeValue = constantValue(*size);
+	if (!sizeValue || *sizeValue == 0 || *sizeValue % 32 != 0 || *sizeValue / 32 > MaxWords)
+		return nullopt;
+	allocation.words = static_cast<size_t>(*sizeValue / 32);
+	return allocation;
+}
+
+Expression const* MemoryScalarReplacer::allocationTail(
+	vector<Statement> const& _statements,
+	size_t _begin,
+	Allocation& _allocation
+) const
+{
+	auto isPointer = [&](Expression const& _expression) {
+		auto const* identifier = get_if<Identifier>(&_expression);
+		return identifier && (identifier->name == _allocation.pointer || _allocation.copies.count(identifier->name));
+	};
+	auto isEnd = [&](Expression const& _expression) {
+		auto const* identifier = get_if<Identifier>(&_expression);
+		return identifier && _allocation.ends.count(identifier->name);
+	};
+	// @returns the size if @a _expression is the sum of the pointer and the size.
+	auto sizeAddedToPointer = [&](Expression const& _expression) -> Expression const* {
+		if (instruction(_expression) != evmasm::Instruction::ADD)
+			return nullptr;
+		auto const& arguments = get<FunctionCall>(_expression).arguments;
+		for (size_t i = 0; i < 2; ++i)
+			if (isPointer(arguments[i]))
+				return &arguments[1 - i];
+		return nullptr;
+	};
+	// The pointer may only be compared inside the allocation.
+	function<bool(Expression const&)> leaksPointer = [&](Expression const& _expression) -> bool {
+		if (holds_alternative<Identifier>(_expression))
+			return isPointer(_expression) || isEnd(_expression);
+		auto const* call = get_if<FunctionCall>(&_expression);
+		if (!call)
+			return false;
+		if (
+			set<optional<evmasm::Instruction>>{
+				evmasm::Instruction::LT,
+				evmasm::Instruction::GT,
+				evmasm::Instruction::EQ,
+				evmasm::Instruction::ISZERO
+			}.count(instruction(_expression)) &&
+			all_of(call->arguments.begin(), call->arguments.end(), [](Expression const& _argument) {
+				return !holds_alternative<FunctionCall>(_argument);
+			})
+		)
+			return false;
+		return any_of(call->arguments.begin(), call->arguments.end(), leaksPointer);
+	};
+
+	Expression const* size = nullptr;
+	for (size_t index = _begin; index < _statements.size(); ++index)
+	{
+		Statement const& statement = _statements[index];
+		if (auto const* varDecl = get_if<VariableDeclaration>(&statement))
+		{
+			if (varDecl->variables.size() != 1 || !varDecl->value)
+				return nullptr;
+			YulString variable = varDecl->variables.front().name;
+			Expression const& value = *varDecl->value;
+			if (holds_alternative<Literal>(value))
+				continue;
+			if (isPointer(value) || isEnd(value))
+			{
+				if (!m_ssaValues.count(variable))
+					return nullptr;
+				(isPointer(value) ? _allocation.copies : _allocation.ends).insert(variable);
+			}
+			else if (holds_alternative<Identifier>(value))
+				continue;
+			else if (!size && (size = sizeAddedToPointer(value)))
+			{
+				if (!m_ssaValues.count(variable))
+					return nullptr;
+				_allocation.ends.insert(variable);
+			}
+			else if (leaksPointer(value))
+				return nullptr;
+		}
+		else if (auto const* ifStatement = get_if<If>(&statement))
+		{
+			if (leaksPointer(*ifStatement->condition))
+				return nullptr;
+			for (auto const& [name, count]: ReferencesCounter::countReferences(ifStatement->body))
+				if (name == _allocation.pointer || _allocation.copies.count(name) || _allocation.ends.count(name))
+					return nullptr;
+		}
+		else if (
+			auto const* expressionStatement = get_if<ExpressionStatement>(&statement);
+			expressionStatement && instruction(expressionStatement->expression) == evmasm::Instruction::MSTORE
+		)
+		{
+			auto const& arguments = get<FunctionCall>(expressionStatement->expression).arguments;
+			if (constantValue(arguments[0]) != u256(64))
+				return nullptr;
+			if (!isEnd(arguments[1]) && (size || !(size = sizeAddedToPointer(arguments[1]))))
+				return nullptr;
+			_allocation.statements = index + 2 - _begin;
+			return size;
+		}
+		else
+			return nullptr;
+	}
+	return nullptr;
+}
+
+bool MemoryScalarReplacer::isAllocationFunction(FunctionDefinition const& _function) const
+{
+	if (_function.parameters.size() != 1 || _function.returnVariables.size() != 1)
+		return false;
+	vector<Statement> const& statements = _function.body.statements;
+	if (statements.empty())
+		return false;
+
+	Allocation allocation{_function.returnVariables.front().name, 0, 1, {}, {}};
+	auto const* assignment = get_if<Assignment>(&statements.front());
+	if (
+		!assignment ||
+		assignment->variableNames.size() != 1 ||
+		assignment->variableNames.front().name != allocation.pointer ||
+		instruction(*assignment->value) != evmasm::Instruction::MLOAD ||
+		constantValue(get<FunctionCall>(*assignment->value).arguments.front()) != u256(64)
+	)
+		return false;
+
+	auto const* size = get_if<Identifier>(allocationTail(statements, 1, allocation));
+	return
+		size &&
+		size->name == _function.parameters.front().name &&
+		allocation.statements == statements.size();
+}
+
+optional<u256> MemoryScalarReplacer::constantValue(Expression const& _expression) const
+{
+	Expression const* expression = &_expression;
+	if (auto const* identifier = get_if<Identifier>(expression))
+		if (m_ssaValues.count(identifier->name) && m_ssaValues.at(identifier->name))
+			expression = m_ssaValues.at(identifier->name);
+	if (auto const* literal = get_if<Literal>(expression))
+		return valueOfLiteral(*literal);
+	return nullopt;
+}
+
+optional<evmasm::Instruction> MemoryScalarReplacer::instruction(Expression const& _expression) const
+{
+	if (auto const* call = get_if<FunctionCall>(&_expression))
+		if (auto const* builtin = m_dialect.builtin(call->functionName.name))
+			return builtin->instruction;
+	return nullopt;
+}
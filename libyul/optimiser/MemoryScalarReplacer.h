@@ -0,0 +1,118 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that keeps small memory objects that do not escape in variables.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/Common.h>
+
+#include <map>
+#include <optional>
+#include <set>
+
+namespace solidity::yul
+{
+
+struct EVMDialect;
+
+/**
+ * Optimisation stage that replaces the words of small memory objects by variables
+ * if the pointer to the object does not escape.
+ *
+ * An object is created either by a call ``let p := f(size)`` to an allocation function
+ * with a constant size or by the inlined form of such a call:
+ *
+ *   let p := mload(64)
+ *   let newFreePtr := add(p, size)
+ *   if or(gt(newFreePtr, 0xffffffffffffffff), lt(newFreePtr, p)) { panic_error() }
+ *   mstore(64, newFreePtr)
+ *
+ * An allocation function is a function whose body has exactly this form, where
+ * ``p`` is the return variable and ``size`` the parameter.
+ *
+ * If ``p`` and variables declared as ``add(p, c)`` for a constant ``c`` are only used
+ * as the address of ``mload`` and ``mstore`` at a multiple of 32 inside the object,
+ * or as the address of ``calldatacopy(p, calldatasize(), size)``, every word of the object
+ * is replaced by a new variable. All words have to be written by the statements directly
+ * following the allocation before any of them is read. The allocation itself is kept,
+ * including its check for an overflow of the free memory pointer.
+ *
+ * Memory is only accessed through pointers obtained from an allocation if the code uses
+ * ``memoryguard``, so the step does nothing otherwise. It also does nothing if ``msize``
+ * is used.
+ *
+ * Prerequisite: Disambiguator, FunctionHoister, FunctionGrouper.
+ */
+class MemoryScalarReplacer: public ASTModifier
+{
+public:
+	static constexpr char const* name{"MemoryScalarReplacer"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	/// Maximum number of words of an object that is replaced.
+	static size_t constexpr MaxWords = 4;
+
+	using ASTModifier::operator();
+	void operator()(ForLoop& _loop) override;
+	void operator()(Block& _block) override;
+
+private:
+	MemoryScalarReplacer(OptimiserStepContext& _context, EVMDialect const& _dialect, Block const& _ast);
+
+	struct Allocation
+	{
+		YulString pointer;
+		/// Size of the object in words.
+		size_t words = 0;
+		/// Number of statements that make up the allocation.
+		size_t statements = 0;
+		/// Copies of the pointer that are declared inside the allocation.
+		std::set<YulString> copies;
+		/// Variables inside the allocation that hold the new free memory pointer.
+		std::set<YulString> ends;
+	};
+	/// @returns the allocation starting at @a _statements[_index], if there is one.
+	std::optional<Allocation> allocationAt(std::vector<Statement> const& _statements, size_t _index) const;
+	/// Checks that the statements starting at @a _begin are the remainder of the inlined
+	/// allocation form described above that follows the load of the free memory pointer
+	/// into the pointer of @a _allocation and completes @a _allocation except for its size.
+	/// Declarations of copies of variables are allowed in between.
+	/// @returns the size expression or nullptr if the statements do not match.
+	Expression const* allocationTail(
+		std::vector<Statement> const& _statements,
+		size_t _begin,
+		Allocation& _allocation
+	) const;
+	bool isAllocationFunction(FunctionDefinition const& _function) const;
+	std::optional<u256> constantValue(Expression const& _expression) const;
+	std::optional<evmasm::Instruction> instruction(Expression const& _expression) const;
+
+	OptimiserStepContext& m_context;
+	EVMDialect const& m_dialect;
+	std::set<YulString> m_allocationFunctions;
+	std::map<YulString, Expression const*> m_ssaValues;
+};
+
+}
@@ -17,6 +17,7 @@
 
 #include <libyul/optimiser/NameSimplifier.h>
 #include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
 #include <libyul/AsmData.h>
 #include <libyul/Dialect.h>
 #include <libyul/optimiser/OptimizerUtilities.h>
@@ -110,6 +111,7 @@ void NameSimplifier::findSimplification(YulString _name)
 	if (name != _name.str())
 	{
 		m_usedNames.insert(YulString(name));
+		m_context.dispenser.markUsed(YulString(name));
 		m_translations[_name] = YulString(name);
 	}
 }
@@ -0,0 +1,130 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that removes storage writes that are overwritten
+ * before they can be observed.
+ */
+
+#include <libyul/optimiser/RedundantStoreEliminator.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/AsmData.h>
+
+#include <boost/range/algorithm_ext/erase.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+void RedundantStoreEliminator::run(OptimiserStepContext& _context, Block& _ast)
+{
+	RedundantStoreEliminator{
+		_context.dialect,
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+	}(_ast);
+}
+
+void RedundantStoreEliminator::operator()(Block& _block)
+{
+	vector<PendingStore> outerPendingStores;
+	swap(m_pendingStores, outerPendingStores);
+	DataFlowAnalyzer::operator()(_block);
+	swap(m_pendingStores, outerPendingStores);
+
+	boost::range::remove_erase_if(_block.statements, [&](Statement const& _statement) {
+		return m_redundantStores.erase(&_statement) > 0;
+	});
+}
+
+void RedundantStoreEliminator::visit(Statement& _statement)
+{
+	// The knowledge of the data flow analyzer refers to the state
+	// before the statement, so the pending stores are updated first.
+	if (auto const* expressionStatement = get_if<ExpressionStatement>(&_statement))
+	{
+		if (auto store = isSimpleStore(evmasm::Instruction::SSTORE, *expressionStatement))
+		{
+			boost::range::remove_erase_if(m_pendingStores, [&](PendingStore const& _pending) {
+				if (!knownToBeSameSlot(_pending.slot, store->first))
+					return false;
+				m_redundantStores.insert(_pending.statement);
+				return true;
+			});
+			m_pendingStores.emplace_back(PendingStore{store->first, &_statement});
+		}
+		else
+			checkExpression(expressionStatement->expression);
+	}
+	else if (auto const* varDecl = get_if<VariableDeclaration>(&_statement))
+	{
+		if (varDecl->value)
+			checkExpression(*varDecl->value);
+	}
+	else if (auto const* assignment = get_if<Assignment>(&_statement))
+	{
+		checkExpression(*assignment->value);
+		for (Identifier const& variable: assignment->variableNames)
+			boost::range::remove_erase_if(m_pendingStores, [&](PendingStore const& _pending) {
+				return _pending.slot == variable.name;
+			});
+	}
+	else
+		// Control flow might leave the block or read storage.
+		m_pendingStores.clear();
+
+	DataFlowAnalyzer::visit(_statement);
+}
+
+void RedundantStoreEliminator::checkExpression(Expression const& _expression)
+{
+	FunctionCall const* funCall = get_if<FunctionCall>(&_expression);
+	if (!funCall)
+		return;
+
+	for (Expression const& argument: funCall->arguments)
+		checkExpression(argument);
+
+	auto const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect);
+	BuiltinFunctionForEVM const* builtin = dialect ? dialect->builtin(funCall->functionName.name) : nullptr;
+	// Calls to user-defined functions and accesses to storage other than a simple
+	// load might observe the pending stores or terminate before they are overwritten.
+	if (!builtin || builtin->controlFlowSideEffects.terminates)
+		m_pendingStores.clear();
+	else if (builtin->instruction == evmasm::Instruction::SLOAD && holds_alternative<Identifier>(funCall->arguments.at(0)))
+		removePendingStores(std::get<Identifier>(funCall->arguments.at(0)).name);
+	else if (builtin->sideEffects.storage != SideEffects::None)
+		m_pendingStores.clear();
+}
+
+void RedundantStoreEliminator::removePendingStores(YulString _slot)
+{
+	boost::range::remove_erase_if(m_pendingStores, [&](PendingStore const& _pending) {
+		return !m_knowledgeBase.knownToBeDifferent(_pending.slot, _slot);
+	});
+}
+
+bool RedundantStoreEliminator::knownToBeSameSlot(YulString _a, YulString _b)
+{
+	if (m_knowledgeBase.knownToBeEqual(_a, _b))
+		return true;
+	optional<u256> a = m_knowledgeBase.valueIfKnownConstant(_a);
+	optional<u256> b = m_knowledgeBase.valueIfKnownConstant(_b);
+	return a && b && *a == *b;
+}
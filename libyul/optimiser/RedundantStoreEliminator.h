@@ -0,0 +1,84 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that removes storage writes that are overwritten
+ * before they can be observed.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <set>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Optimisation stage that removes ``sstore(a, x)`` if it is followed by ``sstore(b, y)``
+ * in the same block, ``a`` and ``b`` are known to be the same slot and no statement
+ * in between can read storage or leave the block.
+ *
+ * Together with the LoadResolver, this combines read-modify-write sequences on the
+ * same slot, like updates of several packed state variables, into a single load
+ * and a single store.
+ *
+ * Works best if the code is in SSA form and the LoadResolver was run before.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class RedundantStoreEliminator: public DataFlowAnalyzer
+{
+public:
+	static constexpr char const* name{"RedundantStoreEliminator"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using DataFlowAnalyzer::operator();
+	void operator()(Block& _block) override;
+
+private:
+	RedundantStoreEliminator(
+		Dialect const& _dialect,
+		std::map<YulString, SideEffects> _functionSideEffects
+	):
+		DataFlowAnalyzer(_dialect, std::move(_functionSideEffects))
+	{}
+
+	using ASTModifier::visit;
+	void visit(Statement& _statement) override;
+
+	/// Removes the pending stores that the expression might observe.
+	void checkExpression(Expression const& _expression);
+	/// Removes the pending stores that might have written to the slot @a _slot.
+	void removePendingStores(YulString _slot);
+	bool knownToBeSameSlot(YulString _a, YulString _b);
+
+	struct PendingStore
+	{
+		YulString slot;
+		Statement const* statement;
+	};
+	/// Stores in the current block that can still be removed if they are overwritten.
+	std::vector<PendingStore> m_pendingStores;
+	/// Stores that are overwritten before they are observed.
+	std::set<Statement const*> m_redundantStores;
+};
+
+}
@@ -56,7 +56,10 @@
 #include <libsolutil/JSON.h>
 
 #include <algorithm>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
@@ -70,6 +73,12 @@
 	#define fileno _fileno
 #else // unix
 	#include <unistd.h>
+	#include <cerrno>
+	#include <csignal>
+	#include <cstring>
+	#include <sys/socket.h>
+	#include <sys/stat.h>
+	#include <sys/un.h>
 #endif
 
 #include <string>
@@ -156,7 +165,9 @@ static string const g_strNone = "none";
 static string const g_strNoOptimizeYul = "no-optimize-yul";
 static string const g_strOpcodes = "opcodes";
 static string const g_strOptimize = "optimize";
+static string const g_strOptimizeExecutionCounts = "optimize-execution-counts";
 static string const g_strOptimizeRuns = "optimize-runs";
+static string const g_strOptimizeStackLayout = "optimize-stack-layout";
 static string const g_strOptimizeYul = "optimize-yul";
 static string const g_strYulOptimizations = "yul-optimizations";
 static string const g_strOutputDir = "output-dir";
@@ -176,6 +187,7 @@ static set<string> const g_revertStringsArgs
 };
 
 static string const g_strSignatureHashes = "hashes";
+static string const g_strServer = "server";
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
 static string const g_strSrcMap = "srcmap";
@@ -228,6 +240,7 @@ static string const g_argOpcodes = g_strOpcodes;
 static string const g_argOptimize = g_strOptimize;
 static string const g_argOptimizeRuns = g_strOptimizeRuns;
 static string const g_argOutputDir = g_strOutputDir;
+static string const g_argServer = g_strServer;
 static string const g_argSignatureHashes = g_strSignatureHashes;
 static string const g_argStandardJSON = g_strStandardJSON;
 static string const g_argStorageLayout = g_strStorageLayout;
@@ -618,13 +631,13 @@ bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 				}
 
 				// NOTE: we ignore the FileNotFound exception as we manually check above
-				m_sourceCodes[infile.generic_string()] = readFileAsString(infile.string());
+				m_sourceCodes[infile.generic_string()] = make_shared<string const>(readFileAsString(infile.string()));
 				path = boost::filesystem::canonical(infile).string();
 			}
 			m_allowedDirectories.push_back(boost::filesystem::path(path).remove_filename());
 		}
 	if (addStdin)
-		m_sourceCodes[g_stdinFileName] = readStandardInput();
+		m_sourceCodes[g_stdinFileName] = make_shared<string const>(readStandardInput());
 	if (m_sourceCodes.size() == 0)
 	{
 		serr() << "No input files given. If you wish to use the standard input please specify \"-\" explicitly." << endl;
@@ -711,12 +724,12 @@ bool CommandLineInterface::parseLibraryOption(string const& _input)
 map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 {
 	map<string, Json::Value> sourceJsons;
-	map<string, string> tmpSources;
+	SharedStringMap tmpSources;
 
 	for (auto const& srcPair: m_sourceCodes)
 	{
 		Json::Value ast;
-		astAssert(jsonParseStrict(srcPair.second, ast), "Input file could not be parsed to JSON");
+		astAssert(jsonParseStrict(*srcPair.second, ast), "Input file could not be parsed to JSON");
 		astAssert(ast.isMember("sources"), "Invalid Format for import-JSON: Must have 'sources'-object");
 
 		for (auto& src: ast["sources"].getMemberNames())
@@ -727,7 +740,7 @@ map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 			astAssert(ast["sources"][src][astKey]["nodeType"].asString() == "SourceUnit",  "Top-level node should be a 'SourceUnit'");
 			astAssert(sourceJsons.count(src) == 0, "All sources must have unique names");
 			sourceJsons.emplace(src, move(ast["sources"][src][astKey]));
-			tmpSources[src] = util::jsonCompactPrint(ast);
+			tmpSources[src] = make_shared<string const>(util::jsonCompactPrint(ast));
 		}
 	}
 
@@ -862,6 +875,13 @@ General Information)").c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
 		)
+		(
+			g_argServer.c_str(),
+			po::value<string>()->value_name("socket"),
+			("Switch to Standard JSON server mode, ignoring all options apart from --" + g_argAllowPaths + " "
+			"and --" + g_argBasePath + ". Listens on the given Unix domain socket and answers every connection "
+			"with the Standard JSON output for the Standard JSON input it received.").c_str()
+		)
 		(
 			g_argLink.c_str(),
 			("Switch to linker mode, ignoring all options apart from --" + g_argLibraries + " "
@@ -1007,6 +1027,17 @@ General Information)").c_str(),
 			"Set for how many contract runs to optimize. "
 			"Lower values will optimize more for initial deployment cost, higher values will optimize more for high-frequency usage."
 		)
+		(
+			g_strOptimizeExecutionCounts.c_str(),
+			po::value<string>()->value_name("path"),
+			"Path to a JSON file that maps external function signatures to recorded numbers of calls. "
+			"Frequently called functions are dispatched first."
+		)
+		(
+			g_strOptimizeStackLayout.c_str(),
+			"Generate EVM code from Yul using stack layouts that are chosen based on the values "
+			"still needed at each point, instead of fixed stack slots for variables. Experimental."
+		)
 		(
 			g_strOptimizeYul.c_str(),
 			("Legacy option, ignored. Use the general --" + g_argOptimize + " to enable Yul optimizer.").c_str()
@@ -1174,7 +1205,7 @@ bool CommandLineInterface::processInput()
 
 			// NOTE: we ignore the FileNotFound exception as we manually check above
 			auto contents = readFileAsString(canonicalPath.string());
-			m_sourceCodes[path.generic_string()] = contents;
+			m_sourceCodes[path.generic_string()] = make_shared<string const>(contents);
 			return ReadCallback::Result{true, contents};
 		}
 		catch (Exception const& _exception)
@@ -1229,6 +1260,7 @@ bool CommandLineInterface::processInput()
 
 	vector<string> const exclusiveModes = {
 		g_argStandardJSON,
+		g_argServer,
 		g_argLink,
 		g_argAssemble,
 		g_argStrictAssembly,
@@ -1242,6 +1274,9 @@ bool CommandLineInterface::processInput()
 		return false;
 	}
 
+	if (m_args.count(g_argServer))
+		return serve(m_args[g_argServer].as<string>(), fileReader);
+
 	if (m_args.count(g_argStandardJSON))
 	{
 		vector<string> inputFiles;
@@ -1405,7 +1440,7 @@ bool CommandLineInterface::processInput()
 			"Warning: Yul is still experimental. Please use the output with care." <<
 			endl;
 
-		return assemble(inputLanguage, targetMachine, optimize, yulOptimiserSteps);
+		return assemble(inputLanguage, targetMachine, optimize, yulOptimiserSteps, m_args.count(g_strOptimizeStackLayout));
 	}
 	else if (countEnabledOptions({g_strYulDialect, g_argMachine}) >= 1)
 	{
@@ -1507,6 +1542,42 @@ bool CommandLineInterface::processInput()
 			settings.yulOptimiserSteps = m_args[g_strYulOptimizations].as<string>();
 		}
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
+		if (m_args.count(g_strOptimizeStackLayout))
+		{
+			if (!settings.runYulOptimiser)
+			{
+				serr() << "--" << g_strOptimizeStackLayout << " is invalid if Yul optimizer is disabled" << endl;
+				return false;
+			}
+			settings.optimizeStackLayout = true;
+		}
+		if (m_args.count(g_strOptimizeExecutionCounts))
+		{
+			string const path = m_args[g_strOptimizeExecutionCounts].as<string>();
+			Json::Value executionCounts;
+			try
+			{
+				if (!jsonParseStrict(readFileAsString(path), executionCounts) || !executionCounts.isObject())
+				{
+					serr() << "Invalid execution counts in --" << g_strOptimizeExecutionCounts << ": expected a JSON object." << endl;
+					return false;
+				}
+			}
+			catch (FileNotFound const&)
+			{
+				serr() << "File not found: " << path << endl;
+				return false;
+			}
+			for (string const& signature: executionCounts.getMemberNames())
+			{
+				if (!executionCounts[signature].isUInt64())
+				{
+					serr() << "Invalid execution count for \"" << signature << "\" in --" << g_strOptimizeExecutionCounts << "." << endl;
+					return false;
+				}
+				settings.functionExecutionCounts[signature] = executionCounts[signature].asUInt64();
+			}
+		}
 		m_compiler->setOptimiserSettings(settings);
 
 		if (m_args.count(g_argImportAst))
@@ -1614,6 +1685,107 @@ bool CommandLineInterface::processInput()
 	return true;
 }
 
+bool CommandLineInterface::serve(string const& _socketPath, ReadCallback::Callback const& _fileReader)
+{
+#ifdef _WIN32
+	(void)_socketPath;
+	(void)_fileReader;
+	serr() << "--" << g_argServer << " is only supported on Unix-like systems." << endl;
+	return false;
+#else
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	if (_socketPath.empty() || _socketPath.size() >= sizeof(address.sun_path))
+	{
+		serr() << "Invalid socket path: \"" << _socketPath << "\"" << endl;
+		return false;
+	}
+	_socketPath.copy(address.sun_path, _socketPath.size());
+
+	// Remove a socket left behind by a previous server, but never any other kind of file.
+	struct stat status;
+	if (lstat(_socketPath.c_str(), &status) == 0 && S_ISSOCK(status.st_mode))
+		unlink(_socketPath.c_str());
+
+	int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (
+		listener < 0 ||
+		::bind(listener, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0 ||
+		listen(listener, SOMAXCONN) != 0
+	)
+	{
+		serr() << "Could not listen on socket \"" << _socketPath << "\": " << strerror(errno) << endl;
+		if (listener >= 0)
+			close(listener);
+		return false;
+	}
+	// Clients closing their connection before reading the response must not terminate the server.
+	signal(SIGPIPE, SIG_IGN);
+
+	// Compilations share global state like the type provider and thus run one at a time.
+	// Requests are received and responses are sent concurrently, though.
+	mutex compilerMutex;
+	mutex connectionsMutex;
+	condition_variable connectionsDone;
+	size_t activeConnections = 0;
+
+	auto handleConnection = [&](int _connection)
+	{
+		string request;
+		char buffer[4096];
+		ssize_t received = 0;
+		while ((received = recv(_connection, buffer, sizeof(buffer), 0)) != 0)
+			if (received > 0)
+				request.append(buffer, static_cast<size_t>(received));
+			else if (errno != EINTR)
+				break;
+
+		if (received == 0)
+		{
+			string response;
+			{
+				lock_guard<mutex> lock(compilerMutex);
+				StandardCompiler compiler(_fileReader);
+				response = compiler.compile(move(request)) + "\n";
+			}
+			for (size_t sent = 0; sent < response.size();)
+			{
+				ssize_t count = send(_connection, response.data() + sent, response.size() - sent, 0);
+				if (count > 0)
+					sent += static_cast<size_t>(count);
+				else if (errno != EINTR)
+					break;
+			}
+		}
+		close(_connection);
+
+		lock_guard<mutex> lock(connectionsMutex);
+		--activeConnections;
+		connectionsDone.notify_all();
+	};
+
+	while (true)
+	{
+		int connection = accept(listener, nullptr, nullptr);
+		if (connection < 0)
+		{
+			if (errno == EINTR || errno == ECONNABORTED)
+				continue;
+			serr() << "Could not accept connection: " << strerror(errno) << endl;
+			break;
+		}
+		lock_guard<mutex> lock(connectionsMutex);
+		++activeConnections;
+		thread(handleConnection, connection).detach();
+	}
+
+	close(listener);
+	unique_lock<mutex> lock(connectionsMutex);
+	connectionsDone.wait(lock, [&]() { return activeConnections == 0; });
+	return false;
+#endif
+}
+
 void CommandLineInterface::handleCombinedJSON()
 {
 	if (!m_args.count(g_argCombinedJson))
@@ -1743,7 +1915,7 @@ void CommandLineInterface::handleAst(string const& _argStr)
 
 bool CommandLineInterface::actOnInput()
 {
-	if (m_args.count(g_argStandardJSON) || m_onlyAssemble)
+	if (m_args.count(g_argStandardJSON) || m_args.count(g_argServer) || m_onlyAssemble)
 		// Already done in "processInput" phase.
 		return true;
 	else if (m_onlyLink)
@@ -1776,8 +1948,9 @@ bool CommandLineInterface::link()
 	}
 	for (auto& src: m_sourceCodes)
 	{
-		auto end = src.second.end();
-		for (auto it = src.second.begin(); it != end;)
+		string source = *src.second;
+		auto end = source.end();
+		for (auto it = source.begin(); it != end;)
 		{
 			while (it != end && *it != '_') ++it;
 			if (it == end) break;
@@ -1788,7 +1961,7 @@ bool CommandLineInterface::link()
 				*(it + placeholderSize - 1) != '_'
 			)
 			{
-				serr() << "Error in binary object file " << src.first << " at position " << (it - src.second.begin()) << endl;
+				serr() << "Error in binary object file " << src.first << " at position " << (it - source.begin()) << endl;
 				serr() << '"' << string(it, it + min(placeholderSize, static_cast<int>(end - it))) << "\" is not a valid link reference." << endl;
 				return false;
 			}
@@ -1805,9 +1978,10 @@ bool CommandLineInterface::link()
 		}
 		// Remove hints for resolved libraries.
 		for (auto const& library: m_libraries)
-			boost::algorithm::erase_all(src.second, "\n" + libraryPlaceholderHint(library.first));
-		while (!src.second.empty() && *prev(src.second.end()) == '\n')
-			src.second.resize(src.second.size() - 1);
+			boost::algorithm::erase_all(source, "\n" + libraryPlaceholderHint(library.first));
+		while (!source.empty() && *prev(source.end()) == '\n')
+			source.resize(source.size() - 1);
+		src.second = make_shared<string const>(std::move(source));
 	}
 	return true;
 }
@@ -1816,11 +1990,11 @@ void CommandLineInterface::writeLinkedFiles()
 {
 	for (auto const& src: m_sourceCodes)
 		if (src.first == g_stdinFileName)
-			sout() << src.second << endl;
+			sout() << *src.second << endl;
 		else
 		{
 			ofstream outFile(src.first);
-			outFile << src.second;
+			outFile << *src.second;
 			if (!outFile)
 			{
 				serr() << "Could not write to file " << src.first << ". Aborting." << endl;
@@ -1851,7 +2025,8 @@ bool CommandLineInterface::assemble(
 	yul::AssemblyStack::Language _language,
 	yul::AssemblyStack::Machine _targetMachine,
 	bool _optimize,
-	optional<string> _yulOptimiserSteps
+	optional<string> _yulOptimiserSteps,
+	bool _optimizeStackLayout
 )
 {
 	solAssert(_optimize || !_yulOptimiserSteps.has_value(), "");
@@ -1863,11 +2038,12 @@ bool CommandLineInterface::assemble(
 		OptimiserSettings settings = _optimize ? OptimiserSettings::full() : OptimiserSettings::minimal();
 		if (_yulOptimiserSteps.has_value())
 			settings.yulOptimiserSteps = _yulOptimiserSteps.value();
+		settings.optimizeStackLayout = _optimizeStackLayout;
 
 		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(m_evmVersion, _language, settings);
 		try
 		{
-			if (!stack.parseAndAnalyze(src.first, src.second))
+			if (!stack.parseAndAnalyze(src.first, *src.second))
 				successful = false;
 			else
 				stack.optimize();
@@ -24,6 +24,7 @@
 
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/DebugSettings.h>
+#include <libsolidity/interface/ReadFile.h>
 #include <libyul/AssemblyStack.h>
 #include <liblangutil/EVMVersion.h>
 
@@ -50,6 +51,12 @@ public:
 	bool actOnInput();
 
 private:
+	/// Listens on the Unix domain socket @a _socketPath and answers every connection with the
+	/// Standard JSON output for the Standard JSON input read from it until the client shuts
+	/// down its sending side.
+	/// @returns false once listening on or accepting connections from the socket fails.
+	bool serve(std::string const& _socketPath, ReadCallback::Callback const& _fileReader);
+
 	bool link();
 	void writeLinkedFiles();
 	/// @returns the ``// <identifier> -> name`` hint for library placeholders.
@@ -61,7 +68,8 @@ private:
 		yul::AssemblyStack::Language _language,
 		yul::AssemblyStack::Machine _targetMachine,
 		bool _optimize,
-		std::optional<std::string> _yulOptimiserSteps = std::nullopt
+		std::optional<std::string> _yulOptimiserSteps = std::nullopt,
+		bool _optimizeStackLayout = false
 	);
 
 	void outputCompilationResults();
@@ -114,8 +122,8 @@ private:
 
 	/// Compiler arguments variable map
 	boost::program_options::variables_map m_args;
-	/// map of input files to source code strings
-	std::map<std::string, std::string> m_sourceCodes;
+	/// map of input files to source code strings, shared with the compiler stack
+	SharedStringMap m_sourceCodes;
 	/// list of remappings
 	std::vector<frontend::CompilerStack::Remapping> m_remappings;
 	/// list of allowed directories to read files from
@@ -28,6 +28,7 @@
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Assembly.h>
 
 #include <boost/test/unit_test.hpp>
@@ -1467,6 +1468,39 @@ BOOST_AUTO_TEST_CASE(cse_replace_too_large_shift)
 	});
 }
 
+BOOST_AUTO_TEST_CASE(constant_optimiser_independent_of_other_constants)
+{
+	// Many constants are optimised in parallel and the results are cached,
+	// which must not change the representation of any of them.
+	vector<u256> constants;
+	for (unsigned i = 0; i < 40; ++i)
+	{
+		constants.emplace_back((u256(1) << (200 + i)) + i);
+		constants.emplace_back(~u256(0x1000 * i));
+	}
+	auto optimised = [](vector<u256> const& _constants) {
+		Assembly assembly;
+		for (u256 const& constant: _constants)
+		{
+			assembly.append(constant);
+			assembly.append(Instruction::POP);
+		}
+		ConstantOptimisationMethod::optimiseConstants(
+			false,
+			200,
+			solidity::test::CommonOptions::get().evmVersion(),
+			assembly
+		);
+		return assembly.items();
+	};
+
+	AssemblyItems expectation;
+	for (u256 const& constant: constants)
+		expectation += optimised({constant});
+	BOOST_CHECK(optimised(constants) == expectation);
+	BOOST_CHECK(optimised(constants) == expectation);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
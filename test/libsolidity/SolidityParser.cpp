@@ -22,6 +22,8 @@
 
 #include <string>
 #include <memory>
+#include <tuple>
+#include <typeinfo>
 #include <liblangutil/Scanner.h>
 #include <libsolidity/parsing/Parser.h>
 #include <liblangutil/ErrorReporter.h>
@@ -608,6 +610,78 @@ BOOST_AUTO_TEST_CASE(inline_asm_end_location)
 	BOOST_CHECK_MESSAGE(visitor.visited, "No inline asm block found?!");
 }
 
+BOOST_AUTO_TEST_CASE(deferred_function_bodies)
+{
+	char const* text = R"(
+		function free(uint a) pure returns (uint) { return a + 1; }
+		contract C {
+			uint x;
+			modifier m(uint a) { require(a > 0); _; }
+			function f(uint a) public m(a) returns (uint b) {
+				if (a > 2) { b = free(a); } else { x = a; }
+				assembly { b := add(b, 1) }
+			}
+			function g() external;
+			function h() public { f({a: 1}); }
+		}
+	)";
+
+	/// Collects the IDs, types and locations of all nodes.
+	class NodeCollector: public ASTConstVisitor
+	{
+	public:
+		vector<tuple<int64_t, string, int, int>> nodes;
+	private:
+		bool visitNode(ASTNode const& _node) override
+		{
+			nodes.emplace_back(_node.id(), typeid(_node).name(), _node.location().start, _node.location().end);
+			return true;
+		}
+	};
+
+	auto parse = [&](bool _deferFunctionBodies)
+	{
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		Parser parser(errorReporter, solidity::test::CommonOptions::get().evmVersion(), false, _deferFunctionBodies);
+		ASTPointer<SourceUnit> sourceUnit = parser.parse(make_shared<Scanner>(CharStream(text, "")));
+		BOOST_REQUIRE(sourceUnit);
+		if (_deferFunctionBodies)
+		{
+			auto contract = dynamic_pointer_cast<ContractDefinition>(sourceUnit->nodes().at(1));
+			BOOST_REQUIRE(contract);
+			for (FunctionDefinition const* function: contract->definedFunctions())
+				if (function->isImplemented())
+					BOOST_CHECK(function->body().statements().empty());
+			BOOST_CHECK(parser.parseDeferredFunctionBodies());
+		}
+		BOOST_CHECK(Error::containsOnlyWarnings(errors));
+		NodeCollector collector;
+		sourceUnit->accept(collector);
+		return collector.nodes;
+	};
+
+	auto eagerNodes = parse(false);
+	auto deferredNodes = parse(true);
+	BOOST_CHECK_GT(eagerNodes.size(), size_t(40));
+	BOOST_CHECK(eagerNodes == deferredNodes);
+}
+
+BOOST_AUTO_TEST_CASE(deferred_function_body_error)
+{
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	Parser parser(errorReporter, solidity::test::CommonOptions::get().evmVersion(), false, true);
+	ASTPointer<SourceUnit> sourceUnit = parser.parse(make_shared<Scanner>(CharStream(
+		"contract C { function f() public { uint x = ; } }",
+		""
+	)));
+	BOOST_REQUIRE(sourceUnit);
+	BOOST_CHECK(!Error::containsErrorOfType(errors, Error::Type::ParserError));
+	BOOST_CHECK(!parser.parseDeferredFunctionBodies());
+	BOOST_CHECK(Error::containsErrorOfType(errors, Error::Type::ParserError));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
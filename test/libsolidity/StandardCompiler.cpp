@@ -371,6 +371,69 @@ BOOST_AUTO_TEST_CASE(optimizer_runs_not_an_unsigned_number)
 	BOOST_CHECK(containsError(result, "JSONError", "The \"runs\" setting must be an unsigned number."));
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_execution_counts_not_unsigned_numbers)
+{
+	char const* input = R"ABCDEF(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": {
+				"enabled": true,
+				"executionCounts": { "f()": "often" }
+			}
+		},
+		"sources": {
+			"empty": {
+				"content": ""
+			}
+		}
+	}
+	)ABCDEF";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "Execution counts in \"settings.optimizer.executionCounts\" must be unsigned numbers."));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_execution_counts)
+{
+	char const* input = R"ABCDEF(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": {
+				"enabled": true,
+				"executionCounts": { "f()": 1000, "b()": 1 }
+			},
+			"outputSelection": {
+				"fileA": { "A": [ "evm.deployedBytecode.object", "evm.methodIdentifiers", "metadata" ] }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function a() public {} function b() public {} function c() public {} function d() public {} function e() public {} function f() public {} }"
+			}
+		}
+	}
+	)ABCDEF";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_REQUIRE(contract.isObject());
+
+	// The selector of f() is the first one that is checked.
+	string code = contract["evm"]["deployedBytecode"]["object"].asString();
+	Json::Value const& selectors = contract["evm"]["methodIdentifiers"];
+	size_t hotSelectorPosition = code.find("63" + selectors["f()"].asString());
+	BOOST_REQUIRE(hotSelectorPosition != string::npos);
+	for (string const& signature: selectors.getMemberNames())
+		if (signature != "f()")
+			BOOST_CHECK(hotSelectorPosition < code.find("63" + selectors[signature].asString()));
+
+	Json::Value metadata;
+	BOOST_REQUIRE(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK_EQUAL(metadata["settings"]["optimizer"]["executionCounts"]["f()"].asUInt(), 1000);
+	BOOST_CHECK(metadata["settings"]["optimizer"]["enabled"].asBool());
+}
+
 BOOST_AUTO_TEST_CASE(basic_compilation)
 {
 	char const* input = R"(
@@ -1755,6 +1818,35 @@ BOOST_AUTO_TEST_CASE(dependency_tracking_of_abstract_contract_yul)
 	BOOST_REQUIRE(result["sources"].size() == 1);
 }
 
+BOOST_AUTO_TEST_CASE(streamed_output_matches_json_output)
+{
+	// "a" and "a.sol" are ordered differently by source name and by fully qualified contract name.
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"a": { "content": "import \"a.sol\"; contract Z is B { function f() public { emit E(); } }" },
+			"a.sol": { "content": "contract B { event E(); } contract A { } contract Empty { }" }
+		},
+		"settings": {
+			"outputSelection": {
+				"*": {
+					"*": [ "abi", "evm.bytecode.object", "evm.methodIdentifiers" ],
+					"": [ "ast", "legacyAST" ]
+				}
+			}
+		}
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	string streamed = compiler.compile(string(input));
+	BOOST_CHECK_EQUAL(streamed, util::jsonCompactPrint(compiler.compile(parsedInput)));
+	BOOST_CHECK(streamed.find("\"ast\":{\"absolutePath\":\"a.sol\"") != string::npos);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
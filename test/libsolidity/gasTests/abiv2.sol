@@ -14,9 +14,9 @@ contract C {
 }
 // ----
 // creation:
-//   codeDepositCost: 1164600
+//   codeDepositCost: 1161800
 //   executionCost: 1207
-//   totalCost: 1165807
+//   totalCost: 1163007
 // external:
 //   a(): 1130
 //   b(uint256): infinite
@@ -17,9 +17,9 @@ contract C {
 // optimize-yul: true
 // ----
 // creation:
-//   codeDepositCost: 578200
+//   codeDepositCost: 580400
 //   executionCost: 613
-//   totalCost: 578813
+//   totalCost: 581013
 // external:
 //   a(): 1029
 //   b(uint256): 2084
@@ -13,8 +13,8 @@ contract C {
 }
 // ----
 // creation:
-//   codeDepositCost: 257000
-//   executionCost: 300
-//   totalCost: 257300
+//   codeDepositCost: 255800
+//   executionCost: 294
+//   totalCost: 256094
 // external:
 //   f(): 252
@@ -11,9 +11,9 @@ contract Medium {
 }
 // ----
 // creation:
-//   codeDepositCost: 253800
+//   codeDepositCost: 251800
 //   executionCost: 294
-//   totalCost: 254094
+//   totalCost: 252094
 // external:
 //   a(): 1028
 //   b(uint256): 2046
@@ -6,9 +6,9 @@ contract Small {
 }
 // ----
 // creation:
-//   codeDepositCost: 85400
-//   executionCost: 135
-//   totalCost: 85535
+//   codeDepositCost: 82400
+//   executionCost: 129
+//   totalCost: 82529
 // external:
 //   fallback: 129
 //   a(): 983
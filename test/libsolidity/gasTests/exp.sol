@@ -19,9 +19,9 @@ contract C {
 // optimize-yul: false
 // ----
 // creation:
-//   codeDepositCost: 119800
+//   codeDepositCost: 116000
 //   executionCost: 165
-//   totalCost: 119965
+//   totalCost: 116165
 // external:
 //   exp_neg_one(uint256): 2259
 //   exp_one(uint256): infinite
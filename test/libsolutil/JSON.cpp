@@ -26,6 +26,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <sstream>
+
 using namespace std;
 
 namespace solidity::util::test
@@ -70,6 +72,46 @@ BOOST_AUTO_TEST_CASE(json_compact_print)
 	BOOST_CHECK("{\"1\":1,\"2\":\"2\",\"3\":{\"3.1\":\"3.1\",\"3.2\":2}}" == jsonCompactPrint(json));
 }
 
+BOOST_AUTO_TEST_CASE(json_stream_writer)
+{
+	Json::Value json;
+	json["int"] = -7;
+	json["uint"] = Json::UInt64(1) << 63;
+	json["real"] = 0.25;
+	json["bool"] = true;
+	json["null"] = Json::nullValue;
+	json["string"] = "quote\" newline\n \xe2\x82\xac";
+	json["nul"] = string("a\0b", 3);
+	json["emptyObject"] = Json::objectValue;
+	json["emptyArray"] = Json::arrayValue;
+	json["array"].append(1);
+	json["array"].append(Json::objectValue);
+	json["array"].append(Json::arrayValue);
+	json["array"].append(json);
+	json["array"][1]["x"]["y"].append("z");
+
+	for (bool pretty: {false, true})
+	{
+		JsonStreamWriter writer(pretty);
+		writer.value(json);
+		BOOST_CHECK_EQUAL(writer.output(), pretty ? jsonPrettyPrint(json) : jsonCompactPrint(json));
+
+		// Write the top level piece by piece and pass the output on to a stream.
+		stringstream stream;
+		{
+			JsonStreamWriter streamWriter(stream, pretty);
+			streamWriter.beginObject();
+			for (auto const& name: json.getMemberNames())
+			{
+				streamWriter.key(name);
+				streamWriter.value(json[name]);
+			}
+			streamWriter.endObject();
+		}
+		BOOST_CHECK_EQUAL(stream.str(), pretty ? jsonPrettyPrint(json) : jsonCompactPrint(json));
+	}
+}
+
 BOOST_AUTO_TEST_CASE(parse_json_strict)
 {
 	Json::Value json;
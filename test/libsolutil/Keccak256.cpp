@@ -69,6 +69,30 @@ BOOST_AUTO_TEST_CASE(strings)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(batch)
+{
+	// Lengths around the block size, so that inputs with
+	// different block counts end up next to each other.
+	vector<bytes> inputs;
+	for (size_t length: vector<size_t>{0, 1, 4, 32, 64, 64, 64, 64, 64, 135, 136, 137, 200, 271, 272, 273, 1000, 1000})
+		inputs.emplace_back(length, static_cast<uint8_t>(length * 7 + inputs.size()));
+	vector<bytesConstRef> refs;
+	for (bytes const& input: inputs)
+		refs.emplace_back(&input);
+
+	vector<h256> hashes = keccak256Batch(refs);
+	BOOST_REQUIRE_EQUAL(hashes.size(), inputs.size());
+	for (size_t i = 0; i < inputs.size(); ++i)
+		BOOST_CHECK_EQUAL(hashes[i], keccak256(inputs[i]));
+
+	string const test = "test";
+	BOOST_CHECK(keccak256Batch({}).empty());
+	BOOST_CHECK_EQUAL(
+		keccak256Batch({bytesConstRef(test)}).front(),
+		FixedHash<32>("0x9c22ff5f21f0b81b113e63f7db6da94fedef11b2119b4088b89664fb9a3cb658")
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
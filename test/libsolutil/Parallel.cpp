@@ -0,0 +1,77 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the parallelFor helper.
+ */
+
+#include <libsolutil/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(Parallel, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(all_indices)
+{
+	for (size_t threads: vector<size_t>{1, 2, 4, 16})
+	{
+		vector<size_t> results(100, 0);
+		parallelFor(results.size(), [&](size_t _index) { results[_index] = _index * _index; }, threads);
+		for (size_t i = 0; i < results.size(); ++i)
+			BOOST_CHECK_EQUAL(results[i], i * i);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+	size_t calls = 0;
+	parallelFor(0, [&](size_t) { ++calls; }, 4);
+	BOOST_CHECK_EQUAL(calls, 0);
+}
+
+BOOST_AUTO_TEST_CASE(lowest_exception)
+{
+	for (size_t threads: vector<size_t>{1, 4})
+	{
+		string message;
+		try
+		{
+			parallelFor(50, [](size_t _index) {
+				if (_index % 10 == 7)
+					throw runtime_error(to_string(_index));
+			}, threads);
+		}
+		catch (runtime_error const& _exception)
+		{
+			message = _exception.what();
+		}
+		BOOST_CHECK_EQUAL(message, "7");
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
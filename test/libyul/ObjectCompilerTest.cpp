@@ -45,15 +45,18 @@ ObjectCompilerTest::ObjectCompilerTest(string const& _filename):
 	m_source = m_reader.source();
 	m_optimize = m_reader.boolSetting("optimize", false);
 	m_wasm = m_reader.boolSetting("wasm", false);
+	m_stackLayout = m_reader.boolSetting("stackLayout", false);
 	m_expectation = m_reader.simpleExpectations();
 }
 
 TestCase::TestResult ObjectCompilerTest::run(ostream& _stream, string const& _linePrefix, bool const _formatted)
 {
+	OptimiserSettings settings = m_optimize ? OptimiserSettings::full() : OptimiserSettings::minimal();
+	settings.optimizeStackLayout = m_stackLayout;
 	AssemblyStack stack(
 		EVMVersion(),
 		m_wasm ? AssemblyStack::Language::Ewasm : AssemblyStack::Language::StrictAssembly,
-		m_optimize ? OptimiserSettings::full() : OptimiserSettings::minimal()
+		settings
 	);
 	if (!stack.parseAndAnalyze("source", m_source))
 	{
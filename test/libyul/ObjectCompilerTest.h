@@ -56,6 +56,7 @@ private:
 
 	bool m_optimize = false;
 	bool m_wasm = false;
+	bool m_stackLayout = false;
 };
 
 }
@@ -38,6 +38,7 @@
 #include <libyul/optimiser/ExpressionSplitter.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/FunctionHoister.h>
+#include <libyul/optimiser/FunctionSpecializer.h>
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
@@ -45,6 +46,8 @@
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopUnroller.h>
+#include <libyul/optimiser/MemoryScalarReplacer.h>
 #include <libyul/optimiser/MainFunction.h>
 #include <libyul/optimiser/StackLimitEvader.h>
 #include <libyul/optimiser/NameDisplacer.h>
@@ -59,6 +62,7 @@
 #include <libyul/optimiser/SSATransform.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/RedundantAssignEliminator.h>
+#include <libyul/optimiser/RedundantStoreEliminator.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/StackToMemoryMover.h>
@@ -264,6 +268,13 @@ TestCase::TestResult YulOptimizerTest::run(ostream& _stream, string const& _line
 		LiteralRematerialiser::run(*m_context, *m_object->code);
 		UnusedFunctionParameterPruner::run(*m_context, *m_object->code);
 	}
+	else if (m_optimizerStep == "functionSpecializer")
+	{
+		disambiguate();
+		FunctionHoister::run(*m_context, *m_object->code);
+		LiteralRematerialiser::run(*m_context, *m_object->code);
+		FunctionSpecializer::run(*m_context, *m_object->code);
+	}
 	else if (m_optimizerStep == "unusedPruner")
 	{
 		disambiguate();
@@ -312,12 +323,32 @@ TestCase::TestResult YulOptimizerTest::run(ostream& _stream, string const& _line
 		ExpressionJoiner::run(*m_context, *m_object->code);
 		ExpressionJoiner::run(*m_context, *m_object->code);
 	}
+	else if (m_optimizerStep == "redundantStoreEliminator")
+	{
+		disambiguate();
+		ForLoopInitRewriter::run(*m_context, *m_object->code);
+		RedundantStoreEliminator::run(*m_context, *m_object->code);
+	}
 	else if (m_optimizerStep == "loopInvariantCodeMotion")
 	{
 		disambiguate();
 		ForLoopInitRewriter::run(*m_context, *m_object->code);
 		LoopInvariantCodeMotion::run(*m_context, *m_object->code);
 	}
+	else if (m_optimizerStep == "loopUnroller")
+	{
+		disambiguate();
+		ForLoopInitRewriter::run(*m_context, *m_object->code);
+		FunctionHoister::run(*m_context, *m_object->code);
+		LoopUnroller::run(*m_context, *m_object->code);
+	}
+	else if (m_optimizerStep == "memoryScalarReplacer")
+	{
+		disambiguate();
+		FunctionHoister::run(*m_context, *m_object->code);
+		FunctionGrouper::run(*m_context, *m_object->code);
+		MemoryScalarReplacer::run(*m_context, *m_object->code);
+	}
 	else if (m_optimizerStep == "controlFlowSimplifier")
 	{
 		disambiguate();
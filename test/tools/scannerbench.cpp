@@ -0,0 +1,162 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Measures the throughput of the scanner on a corpus of Solidity and Yul sources.
+ */
+
+#include <liblangutil/Scanner.h>
+
+#include <libsolutil/CommonIO.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+struct Source
+{
+	string name;
+	shared_ptr<string const> content;
+	ScannerKind kind;
+};
+
+void collectSources(fs::path const& _path, vector<Source>& _sources)
+{
+	auto add = [&](fs::path const& _file)
+	{
+		if (_file.extension() == ".sol")
+			_sources.push_back({_file.string(), make_shared<string const>(readFileAsString(_file.string())), ScannerKind::Solidity});
+		else if (_file.extension() == ".yul")
+			_sources.push_back({_file.string(), make_shared<string const>(readFileAsString(_file.string())), ScannerKind::Yul});
+	};
+
+	if (fs::is_directory(_path))
+	{
+		for (auto const& entry: fs::recursive_directory_iterator(_path))
+			if (fs::is_regular_file(entry.path()))
+				add(entry.path());
+	}
+	else
+		add(_path);
+}
+
+/// @returns the number of tokens in @a _source, not counting the final EOS token.
+size_t countTokens(Source const& _source)
+{
+	Scanner scanner(CharStream(_source.content, _source.name));
+	scanner.setScannerMode(_source.kind);
+	size_t tokens = 0;
+	for (Token token = scanner.currentToken(); token != Token::EOS; token = scanner.next())
+		++tokens;
+	return tokens;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(scannerbench, scanner throughput measurement.
+Usage: scannerbench [Options] <path>...
+Scans all .sol and .yul files in the given files and directories
+and reports the number of tokens and bytes scanned per second.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		(
+			"input-path",
+			po::value<vector<string>>(),
+			"input file or directory"
+		)
+		(
+			"repeat",
+			po::value<size_t>()->default_value(5),
+			"Number of times the whole corpus is scanned."
+		)
+		("help", "Show this help screen.");
+
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-path", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-path"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	vector<Source> sources;
+	try
+	{
+		for (string const& path: arguments["input-path"].as<vector<string>>())
+			collectSources(path, sources);
+	}
+	catch (fs::filesystem_error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	size_t bytes = 0;
+	for (Source const& source: sources)
+		bytes += source.content->size();
+
+	size_t const repeat = max<size_t>(arguments["repeat"].as<size_t>(), 1);
+	size_t tokens = 0;
+	auto const start = chrono::steady_clock::now();
+	for (size_t i = 0; i < repeat; ++i)
+		for (Source const& source: sources)
+			tokens += countTokens(source);
+	double const seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	cout << "Files:          " << sources.size() << endl;
+	cout << "Bytes:          " << bytes << endl;
+	cout << "Tokens:         " << tokens / repeat << endl;
+	cout << "Seconds:        " << seconds / static_cast<double>(repeat) << endl;
+	cout << "Tokens/second:  " << static_cast<size_t>(static_cast<double>(tokens) / seconds) << endl;
+	cout << "MB/second:      " << static_cast<double>(bytes * repeat) / seconds / 1e6 << endl;
+	return 0;
+}
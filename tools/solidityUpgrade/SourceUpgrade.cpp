@@ -26,6 +26,8 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
+
 #ifdef _WIN32 // windows
 	#include <io.h>
 	#define isatty _isatty
@@ -270,7 +272,7 @@ void SourceUpgrade::tryCompile() const
 	bool verbose = m_args.count(g_argVerbose);
 
 	if (verbose)
-		log() << "Running compilation phases." << endl << endl;
+		log() << "Running parsing and analysis phases." << endl << endl;
 	else
 		logProgress();
 
@@ -278,18 +280,15 @@ void SourceUpgrade::tryCompile() const
 	{
 		if (m_compiler->parse())
 		{
-			if (m_compiler->analyze())
-				m_compiler->compile();
-			else
-				if (verbose)
-				{
-					error() <<
-						"Compilation errors that solidity-upgrade may resolve occurred." <<
-						endl <<
-						endl;
+			if (!m_compiler->analyze() && verbose)
+			{
+				error() <<
+					"Compilation errors that solidity-upgrade may resolve occurred." <<
+					endl <<
+					endl;
 
-					printErrors();
-				}
+				printErrors();
+			}
 		}
 		else
 			if (verbose)
@@ -318,81 +317,106 @@ void SourceUpgrade::tryCompile() const
 
 void SourceUpgrade::runUpgrade()
 {
-	bool recompile = true;
-
-	while (recompile && !m_compiler->errors().empty())
+	set<string> modifiedSources;
+	for (auto const& sourceCode: m_sourceCodes)
+		modifiedSources.insert(sourceCode.first);
+
+	while (
+		!modifiedSources.empty() &&
+		!m_compiler->errors().empty() &&
+		m_compiler->state() >= CompilerStack::State::AnalysisPerformed
+	)
 	{
-		for (auto& sourceCode: m_sourceCodes)
-		{
-			recompile = analyzeAndUpgrade(sourceCode);
-			if (recompile)
-				break;
-		}
+		set<string> affected = affectedSources(modifiedSources);
+
+		// Changes that were not applied to sources that are not affected by the
+		// last round would be found again.
+		auto& changes = m_suite.changes();
+		changes.erase(
+			remove_if(changes.begin(), changes.end(), [&](UpgradeChange const& _change) {
+				return affected.count(_change.location().source->name());
+			}),
+			changes.end()
+		);
+
+		for (auto const& sourceCode: m_sourceCodes)
+			if (affected.count(sourceCode.first))
+				analyze(sourceCode.first);
 
-		if (recompile)
+		modifiedSources = applyChanges();
+		if (!modifiedSources.empty())
 		{
-			m_suite.reset();
 			resetCompiler();
 			tryCompile();
 		}
 	}
 }
 
-bool SourceUpgrade::analyzeAndUpgrade(pair<string, string> const& _sourceCode)
+set<string> SourceUpgrade::affectedSources(set<string> const& _modifiedSources) const
 {
-	bool applyUnsafe = m_args.count(g_argUnsafe);
-	bool verbose = m_args.count(g_argVerbose);
+	set<string> affected = _modifiedSources;
+	for (auto const& sourceCode: m_sourceCodes)
+		for (SourceUnit const* import: m_compiler->ast(sourceCode.first).referencedSourceUnits(true))
+			if (_modifiedSources.count(*import->annotation().path))
+				affected.insert(sourceCode.first);
+	return affected;
+}
 
-	if (verbose)
-		log() << "Analyzing and upgrading " << _sourceCode.first << "." << endl;
+void SourceUpgrade::analyze(string const& _sourceName)
+{
+	if (m_args.count(g_argVerbose))
+		log() << "Analyzing " << _sourceName << "." << endl;
+
+	m_suite.analyze(m_compiler->ast(_sourceName));
+}
 
-	if (m_compiler->state() >= CompilerStack::State::AnalysisPerformed)
-		m_suite.analyze(m_compiler->ast(_sourceCode.first));
+set<string> SourceUpgrade::applyChanges()
+{
+	bool applyUnsafe = m_args.count(g_argUnsafe);
+	bool dryRun = m_args.count(g_argDryRun);
 
-	if (!m_suite.changes().empty())
+	map<string, vector<UpgradeChange const*>> changesBySource;
+	for (UpgradeChange const& change: m_suite.changes())
 	{
-		auto& change = m_suite.changes().front();
+		if (change.level() == UpgradeChange::Level::Unsafe && !applyUnsafe)
+			continue;
 
-		if (verbose)
-			change.log(true);
+		auto& changes = changesBySource[change.location().source->name()];
+		if (none_of(changes.begin(), changes.end(), [&](UpgradeChange const* _other) { return change.overlaps(*_other); }))
+			changes.emplace_back(&change);
+	}
 
-		if (change.level() == UpgradeChange::Level::Safe)
-		{
-			applyChange(_sourceCode, change);
-			return true;
-		}
-		else if (change.level() == UpgradeChange::Level::Unsafe)
-		{
-			if (applyUnsafe)
-			{
-				applyChange(_sourceCode, change);
-				return true;
-			}
-		}
+	set<string> modifiedSources;
+	for (auto& [sourceName, changes]: changesBySource)
+	{
+		if (changes.empty())
+			continue;
+
+		// Apply from back to front, so that the locations of the remaining changes stay valid.
+		sort(changes.begin(), changes.end(), [](UpgradeChange const* _a, UpgradeChange const* _b) {
+			return _a->location().start > _b->location().start;
+		});
+		for (UpgradeChange const* change: changes)
+			applyChange(sourceName, *change);
+
+		if (!dryRun)
+			writeInputFile(sourceName, m_sourceCodes.at(sourceName));
+		modifiedSources.insert(sourceName);
 	}
 
-	return false;
+	return modifiedSources;
 }
 
-void SourceUpgrade::applyChange(
-	pair<string, string> const& _sourceCode,
-	UpgradeChange& _change
-)
+void SourceUpgrade::applyChange(string const& _sourceName, UpgradeChange const& _change)
 {
-	bool dryRun = m_args.count(g_argDryRun);
-	bool verbose = m_args.count(g_argVerbose);
-
-	if (verbose)
+	if (m_args.count(g_argVerbose))
 	{
-		log() << "Applying change to " << _sourceCode.first << endl << endl;
+		_change.log(true);
+		log() << "Applying change to " << _sourceName << endl << endl;
 		log() << _change.patch();
 	}
 
-	_change.apply();
-	m_sourceCodes[_sourceCode.first] = _change.source();
-
-	if (!dryRun)
-		writeInputFile(_sourceCode.first, _change.source());
+	_change.apply(m_sourceCodes.at(_sourceName));
 }
 
 void SourceUpgrade::printErrors() const
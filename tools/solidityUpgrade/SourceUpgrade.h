@@ -31,6 +31,8 @@
 #include <boost/filesystem/path.hpp>
 
 #include <memory>
+#include <set>
+#include <string>
 
 namespace solidity::tools
 {
@@ -116,28 +118,27 @@ private:
 		};
 	};
 
-	/// Parses the current sources and runs analyses as well as compilation on
-	/// them if parsing was successful.
+	/// Parses the current sources and runs analyses on them if parsing was
+	/// successful. No code is generated, since upgrades only need the annotated AST.
 	void tryCompile() const;
-	/// Analyses and upgrades the sources given. The upgrade happens in a loop,
-	/// applying one change at a time, which is run until no applicable changes
-	/// are found any more. Only one change is done at a time and all sources
-	/// are being compiled again after each change.
+	/// Analyses and upgrades the sources given. The upgrade happens in rounds,
+	/// which are run until no applicable changes are found any more. Each round
+	/// applies all changes that do not overlap with each other and then parses
+	/// and analyses the sources again. Upgrade analysis is only run again on sources
+	/// that were modified in the last round or import one of them.
 	void runUpgrade();
-	/// Runs upgrade analysis on source and applies upgrades changes to it.
-	/// Returns `true` if there're still changes that can be applied,
-	/// `false` otherwise.
-	bool analyzeAndUpgrade(
-		std::pair<std::string, std::string> const& _sourceCode
-	);
-
-	/// Applies the change given to its source code. If no `--dry-run` was
-	/// passed via the commandline, the upgraded source code is written back
-	/// to its file.
-	void applyChange(
-		std::pair<std::string, std::string> const& _sourceCode,
-		UpgradeChange& _change
-	);
+	/// @returns the sources that are in @a _modifiedSources or import one of them,
+	/// directly or indirectly.
+	std::set<std::string> affectedSources(std::set<std::string> const& _modifiedSources) const;
+	/// Runs upgrade analysis on the source given and adds the changes found to the suite.
+	void analyze(std::string const& _sourceName);
+	/// Applies all changes of the suite that can be applied and do not overlap with
+	/// a change that comes before them. If no `--dry-run` was passed via the
+	/// commandline, the upgraded source code is written back to its file.
+	/// @returns the names of the sources that were modified.
+	std::set<std::string> applyChanges();
+	/// Applies the change given to the source code with the given name.
+	void applyChange(std::string const& _sourceName, UpgradeChange const& _change);
 
 	/// Prints all errors (excluding warnings) the compiler currently reported.
 	void printErrors() const;
@@ -26,14 +26,21 @@ using namespace solidity::langutil;
 using namespace solidity::util;
 using namespace solidity::tools;
 
-void UpgradeChange::apply()
+void UpgradeChange::apply(string& _source) const
 {
-	m_source.replace(
+	_source.replace(
 		static_cast<size_t>(m_location.start),
 		static_cast<size_t>(m_location.end - m_location.start), m_patch
 	);
 }
 
+bool UpgradeChange::overlaps(UpgradeChange const& _other) const
+{
+	return
+		m_location.start == _other.m_location.start ||
+		(m_location.start < _other.m_location.end && _other.m_location.start < m_location.end);
+}
+
 void UpgradeChange::log(bool const _shorten) const
 {
 	stringstream os;